@@ -24,9 +24,42 @@
 #define BMP_RGB565_BIT_FIELD_SIZE	16
 static const uint32_t AllHeaderOffset = BMP_RGB565_FILE_HEADER_SIZE + BMP_RGB565_INFO_HEADER_SIZE + BMP_RGB565_BIT_FIELD_SIZE;
 
+#define BMP_RGB565_TILE_SIZE	16	// Tile size [pixel] of rotate/transpose
+#define BMP_RGB565_STATS_LANES	8	// Number of independent accumulators of statistics
+#define BMP_RGB565_STATS_BLOCK	4096	// Number of values summed in float/uint32_t before flushing
+#define BMP_RGB565_AUTORANGE_BINS	256	// Number of histogram bins of auto-ranging
+#define BMP_RGB565_PACKED_FONT_HEADER_SIZE	12
+#define BMP_RGB565_FILTER_MAX_RADIUS	1024	// Maximum filter radius [pixel]
+#define BMP_RGB565_MAX_DIMENSION	0x7FFFFFFF	// Maximum width/height (signed 32-bit in the header) [pixel]
+#define BMP_RGB565_MAX_FILE_SIZE	0xFFFFFFFF	// Maximum file size (32-bit in the header) [byte]
+
 /* Private types -------------------------------------------------------------*/
 /* Private enum tag ----------------------------------------------------------*/
 /* Private struct/union tag --------------------------------------------------*/
+// Row access of a filter source/destination. Rows are planar: channel c of pixel x is row[c * width + x]
+typedef struct
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    void (*load)(const void *, uint32_t, uint32_t, float *);
+    void (*store)(void *, uint32_t, uint32_t, const float *);
+    const void *src;
+    void *dst;
+} BMP_RGB565_filterIO_st;
+
+// Pixel access of a text destination. Glyphs are clipped to width x height
+typedef struct
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t bits;
+    uint32_t value;
+    void *(*getRow)(const void *, uint32_t);
+    void (*put)(void *, uint32_t, uint32_t, uint32_t);
+    const void *dst;
+} BMP_RGB565_textIO_st;
+
 /* Private variables ---------------------------------------------------------*/
 static BMP_RGB565_Malloc_Function bmp_rgb565_malloc = malloc;
 static BMP_RGB565_free_Function bmp_rgb565_free = free;
@@ -115,6 +148,9 @@ const BMP_RGB565_font_st BMP_RGB565_FONT_32X53	= {(uint8_t *)font_32x53,32,53};
 /* Exported function prototypes ----------------------------------------------*/
 void	  BMP_RGB565_setAllocFunc(BMP_RGB565_Malloc_Function, BMP_RGB565_free_Function);
 uint8_t * BMP_RGB565_create      (uint32_t, uint32_t);
+uint32_t  BMP_RGB565_calcFileSize(uint32_t, uint32_t);
+void      BMP_RGB565_init        (uint8_t *, uint32_t, uint32_t);
+int       BMP_RGB565_initHeader  (uint8_t *, uint32_t, uint32_t);
 void      BMP_RGB565_free        (uint8_t *);
 uint32_t  BMP_RGB565_getWidth    (uint8_t *);
 uint32_t  BMP_RGB565_getHeight   (uint8_t *);
@@ -127,9 +163,80 @@ void      BMP_RGB565_drawLineRGB (uint8_t *, int32_t, int32_t, int32_t, int32_t,
 void      BMP_RGB565_drawRectRGB (uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, uint8_t, uint8_t, uint8_t);
 void      BMP_RGB565_fillRGB     (uint8_t *, uint8_t, uint8_t, uint8_t);
 void      BMP_RGB565_drawTextRGB(uint8_t *, char *, BMP_RGB565_font_st, uint32_t, uint32_t, uint8_t, uint8_t, uint8_t);
+uint16_t *BMP_RGB565_getRow      (uint8_t *, uint32_t);
+void      BMP_RGB565_setPixel565 (uint8_t *, uint32_t, uint32_t, uint16_t);
+uint16_t  BMP_RGB565_getPixel565 (uint8_t *, uint32_t, uint32_t);
+void      BMP_RGB565_drawLine565 (uint8_t *, int32_t, int32_t, int32_t, int32_t, uint16_t);
+void      BMP_RGB565_drawRect565 (uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, uint16_t);
+void      BMP_RGB565_fill565     (uint8_t *, uint16_t);
+void      BMP_RGB565_drawText565 (uint8_t *, const char *, BMP_RGB565_font_st, uint32_t, uint32_t, uint16_t);
+int       BMP_RGB565_loadPackedFont(const uint8_t *, size_t, BMP_RGB565_packedFont_st *);
+size_t    BMP_RGB565_packFont    (BMP_RGB565_font_st, uint8_t, uint8_t, const char *, uint8_t *, size_t);
+void      BMP_RGB565_drawTextPacked565(uint8_t *, const char *, const BMP_RGB565_packedFont_st *, uint32_t, uint32_t, uint16_t);
+void      BMP_RGB565_measureText (const char *, BMP_RGB565_font_st, uint32_t *, uint32_t *);
+void      BMP_RGB565_measureTextPacked(const char *, const BMP_RGB565_packedFont_st *, uint32_t *, uint32_t *);
 uint8_t * BMP_RGB565_copy(uint8_t *);
 uint8_t * BMP_RGB565_resize_bicubic(uint8_t *, uint32_t, uint32_t);
+uint8_t * BMP_RGB565_rotate90    (uint8_t *);
+uint8_t * BMP_RGB565_rotate270   (uint8_t *);
+uint8_t * BMP_RGB565_transpose   (uint8_t *);
+void      BMP_RGB565_rotate180   (uint8_t *);
+void      BMP_RGB565_flipHorizontal(uint8_t *);
+void      BMP_RGB565_flipVertical(uint8_t *);
+void      BMP_RGB565_scrollRGB   (uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, int32_t, int32_t, uint8_t, uint8_t, uint8_t);
+void      BMP_RGB565_scroll565   (uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, int32_t, int32_t, uint16_t);
+void      BMP_RGB565_ringInit    (BMP_RGB565_ring_st *, uint8_t *);
+void      BMP_RGB565_ringScroll565(BMP_RGB565_ring_st *, int32_t, int32_t, uint16_t);
+uint16_t *BMP_RGB565_ringGetRow  (BMP_RGB565_ring_st *, uint32_t);
+void      BMP_RGB565_ringSetPixel565(BMP_RGB565_ring_st *, uint32_t, uint32_t, uint16_t);
+uint16_t  BMP_RGB565_ringGetPixel565(BMP_RGB565_ring_st *, uint32_t, uint32_t);
+void      BMP_RGB565_ringFlatten (BMP_RGB565_ring_st *);
+int       BMP_RGB565_statsFloat  (const float *, uint32_t, BMP_RGB565_stats_st *);
+int       BMP_RGB565_statsUint16 (const uint16_t *, uint32_t, BMP_RGB565_stats_st *);
+int       BMP_RGB565_histogramFloat (const float *, uint32_t, float, float, uint32_t *, uint32_t);
+int       BMP_RGB565_histogramUint16(const uint16_t *, uint32_t, uint16_t, uint16_t, uint32_t *, uint32_t);
+float     BMP_RGB565_histogramPercentile(const uint32_t *, uint32_t, float, float, float);
+void      BMP_RGB565_rangeUpdate (BMP_RGB565_range_st *, float, float, float);
+int       BMP_RGB565_autoRangeFloat (const float *, uint32_t, float, float, float, BMP_RGB565_range_st *);
+int       BMP_RGB565_autoRangeUint16(const uint16_t *, uint32_t, float, float, float, BMP_RGB565_range_st *);
+int       BMP_RGB565_filter      (uint8_t *, uint8_t *, BMP_RGB565_filter_t, float);
+int       BMP_RGB565_filterBand  (uint8_t *, uint8_t *, BMP_RGB565_filter_t, float, uint32_t, uint32_t);
+int       BMP_RGB565_filterFloat (const float *, float *, uint32_t, uint32_t, BMP_RGB565_filter_t, float);
+int       BMP_RGB565_filterFloatBand(const float *, float *, uint32_t, uint32_t, BMP_RGB565_filter_t, float, uint32_t, uint32_t);
 int 	  BMP_RGB565_colorScale(float, float, float, uint8_t *, uint8_t *, uint8_t *);
+uint8_t * BMP_RGB565_createIndexed(uint32_t, uint32_t, uint32_t);
+uint32_t  BMP_RGB565_calcIndexedFileSize(uint32_t, uint32_t, uint32_t);
+uint32_t  BMP_RGB565_getBitCount(uint8_t *);
+int       BMP_RGB565_setPaletteEntry(uint8_t *, uint32_t, uint8_t, uint8_t, uint8_t);
+int       BMP_RGB565_setColorScalePalette(uint8_t *, uint32_t);
+uint32_t  BMP_RGB565_getPalette565(uint8_t *, uint16_t *);
+uint8_t   BMP_RGB565_valueToIndex(float, float, float, uint32_t);
+int       BMP_RGB565_valuesToIndexed(uint8_t *, const float *, float, float, uint32_t);
+int       BMP_RGB565_expandIndexed(uint8_t *, uint8_t *);
+uint8_t * BMP_RGB565_getIndexedRow(uint8_t *, uint32_t);
+void      BMP_RGB565_setPixelIndex(uint8_t *, uint32_t, uint32_t, uint8_t);
+uint8_t   BMP_RGB565_getPixelIndex(uint8_t *, uint32_t, uint32_t);
+void      BMP_RGB565_drawLineIndex(uint8_t *, int32_t, int32_t, int32_t, int32_t, uint8_t);
+void      BMP_RGB565_drawRectIndex(uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, uint8_t);
+void      BMP_RGB565_fillIndex(uint8_t *, uint8_t);
+void      BMP_RGB565_drawTextIndex(uint8_t *, const char *, BMP_RGB565_font_st, uint32_t, uint32_t, uint8_t);
+int       BMP_RGB565_viewInit(BMP_RGB565_view_st *, uint8_t *, int32_t, int32_t, uint32_t, uint32_t);
+int       BMP_RGB565_viewSub(BMP_RGB565_view_st *, const BMP_RGB565_view_st *, int32_t, int32_t, uint32_t, uint32_t);
+uint16_t *BMP_RGB565_viewGetRow(const BMP_RGB565_view_st *, uint32_t);
+void      BMP_RGB565_viewSetPixel565(const BMP_RGB565_view_st *, int32_t, int32_t, uint16_t);
+uint16_t  BMP_RGB565_viewGetPixel565(const BMP_RGB565_view_st *, int32_t, int32_t);
+void      BMP_RGB565_viewDrawLine565(const BMP_RGB565_view_st *, int32_t, int32_t, int32_t, int32_t, uint16_t);
+void      BMP_RGB565_viewDrawRect565(const BMP_RGB565_view_st *, int32_t, int32_t, int32_t, int32_t, uint16_t);
+void      BMP_RGB565_viewFill565(const BMP_RGB565_view_st *, uint16_t);
+void      BMP_RGB565_viewDrawText565(const BMP_RGB565_view_st *, const char *, BMP_RGB565_font_st, int32_t, int32_t, uint16_t);
+void      BMP_RGB565_viewBlit(const BMP_RGB565_view_st *, const BMP_RGB565_view_st *, int32_t, int32_t);
+int       BMP_RGB565_viewResizeBicubic(const BMP_RGB565_view_st *, const BMP_RGB565_view_st *);
+int       BMP_RGB565_viewFilter(const BMP_RGB565_view_st *, const BMP_RGB565_view_st *, BMP_RGB565_filter_t, float);
+int       BMP_RGB565_viewFilterBand(const BMP_RGB565_view_st *, const BMP_RGB565_view_st *, BMP_RGB565_filter_t, float, uint32_t, uint32_t);
+uint8_t * BMP_RGB565_viewToImage(const BMP_RGB565_view_st *);
+int       BMP_RGB565_statsFloatROI(const float *, uint32_t, uint32_t, uint32_t, BMP_RGB565_stats_st *);
+int       BMP_RGB565_statsUint16ROI(const uint16_t *, uint32_t, uint32_t, uint32_t, BMP_RGB565_stats_st *);
+int       BMP_RGB565_histogramFloatROI(const float *, uint32_t, uint32_t, uint32_t, float, float, uint32_t *, uint32_t);
 
 /* Private function prototypes -----------------------------------------------*/
 static uint16_t convertRGBtoRGB565(uint8_t, uint8_t, uint8_t);
@@ -138,6 +245,29 @@ static uint16_t BMP_RGB565_read_uint16_t(uint8_t *);
 static void BMP_RGB565_write_uint32_t(uint32_t, uint8_t *);
 static void BMP_RGB565_write_uint16_t(uint16_t, uint8_t *);
 static uint32_t BMP_RGB565_getBytesPerRow(uint32_t);
+static uint8_t *BMP_RGB565_getRowAddr(uint8_t *, uint32_t);
+static void BMP_RGB565_viewGetRGB(const BMP_RGB565_view_st *, uint32_t, uint32_t, uint8_t *);
+static uint32_t BMP_RGB565_getIndexedBytesPerRow(uint32_t, uint32_t);
+static bool BMP_RGB565_is565(uint8_t *);
+static bool BMP_RGB565_isIndexed(uint8_t *);
+static uint8_t *BMP_RGB565_getIndexedRowAddr(uint8_t *, uint32_t);
+static void BMP_RGB565_putIndex(uint8_t *, uint32_t, uint32_t, uint8_t);
+static void *BMP_RGB565_textViewRow(const void *, uint32_t);
+static void *BMP_RGB565_textIndexedRow(const void *, uint32_t);
+static void BMP_RGB565_textPut565(void *, uint32_t, uint32_t, uint32_t);
+static void BMP_RGB565_textPutIndex(void *, uint32_t, uint32_t, uint32_t);
+static void BMP_RGB565_textRun(const BMP_RGB565_textIO_st *, const char *, BMP_RGB565_font_st, int64_t, int64_t);
+static void BMP_RGB565_reverseRow(uint16_t *, uint32_t);
+static void BMP_RGB565_reverseRows(uint8_t *, uint32_t, uint32_t);
+static uint8_t *BMP_RGB565_transposeTiled(uint8_t *, bool, bool);
+static void BMP_RGB565_filterLoadView(const void *, uint32_t, uint32_t, float *);
+static void BMP_RGB565_filterStoreView(void *, uint32_t, uint32_t, const float *);
+static void BMP_RGB565_filterLoadFloat(const void *, uint32_t, uint32_t, float *);
+static void BMP_RGB565_filterStoreFloat(void *, uint32_t, uint32_t, const float *);
+static float BMP_RGB565_median9(float *);
+static void BMP_RGB565_statsFloatRun(const float *, uint32_t, float *, float *, double *, uint64_t *);
+static void BMP_RGB565_histogramFloatRun(const float *, uint32_t, float, float, uint32_t *, uint32_t);
+static int BMP_RGB565_filterRun(const BMP_RGB565_filterIO_st *, BMP_RGB565_filter_t, float, uint32_t, uint32_t);
 
 /* Exported functions --------------------------------------------------------*/
 /**
@@ -158,24 +288,83 @@ void BMP_RGB565_setAllocFunc(BMP_RGB565_Malloc_Function malloc_func, BMP_RGB565_
   * @brief  Create BMP RGB565 image.
   * @param  width width of image [pixel]
   * @param  height height of image [pixel]
-  * @retval pointer to the created image. When error, return NULL
+  * @retval pointer to the created image. When error (including a size too large for a BMP file), return NULL
   */
 uint8_t *BMP_RGB565_create(uint32_t width, uint32_t height)
 {
     uint8_t *pbmp;
-    uint32_t bytes_per_row = BMP_RGB565_getBytesPerRow(width);
-    uint32_t image_size = bytes_per_row * height;
-    uint32_t data_size = AllHeaderOffset + image_size;
+    uint32_t data_size = BMP_RGB565_calcFileSize(width, height);
+    if (data_size == 0)
+        return NULL;
 
     /* Allocate the bitmap data */
     pbmp = (uint8_t *)bmp_rgb565_malloc(sizeof(uint8_t) * data_size);
     if (pbmp == NULL)
         return NULL;
+
+    BMP_RGB565_init(pbmp, width, height);
+    return pbmp;
+}
+
+/**
+  * @brief  Calculate file size of an image.
+  * @param  width width of image [pixel]
+  * @param  height height of image [pixel]
+  * @retval file size (header + pixel data) [byte].
+  *         When the size exceeds the limits of a BMP file (see BMP_RGB565_initHeader()), return 0
+  */
+uint32_t BMP_RGB565_calcFileSize(uint32_t width, uint32_t height)
+{
+    if (width > BMP_RGB565_MAX_DIMENSION || height > BMP_RGB565_MAX_DIMENSION)
+        return 0;
+
+    uint64_t bytes_per_row = (((uint64_t)width << 1) + 3) & ~(uint64_t)3;
+    uint64_t data_size = AllHeaderOffset + bytes_per_row * height;
+    return (data_size > BMP_RGB565_MAX_FILE_SIZE) ? 0 : (uint32_t)data_size;
+}
+
+/**
+  * @brief  Initialize BMP RGB565 image in a caller-provided buffer.
+  * @param  pbmp pointer to a buffer of at least BMP_RGB565_calcFileSize(width, height) bytes
+  * @param  width width of image [pixel]
+  * @param  height height of image [pixel]
+  * @retval None
+  * @detail The pixels are cleared to black. Free the buffer with the allocator it came from,
+  *         not with BMP_RGB565_free().
+  *         Nothing is written when BMP_RGB565_calcFileSize() returns 0.
+  */
+void BMP_RGB565_init(uint8_t *pbmp, uint32_t width, uint32_t height)
+{
+    uint32_t data_size = BMP_RGB565_calcFileSize(width, height);
+
+    if (pbmp == NULL || data_size == 0)
+        return;
     for(uint32_t i = 0; i < data_size; i++)
         *(pbmp + i) = 0;
 
+    BMP_RGB565_initHeader(pbmp, width, height);
+}
+
+/**
+  * @brief  Write the header of a BMP RGB565 image.
+  * @param  pHeader pointer to a buffer of BMP_RGB565_HEADER_SIZE bytes
+  * @param  width width of image [pixel]
+  * @param  height height of image [pixel]
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Fails when width or height exceeds 2^31-1 pixels or the file size exceeds 4 GiB - 1 byte,
+  *         which the 32-bit fields of a BMP header cannot hold.
+  *         Used with BMP_RGB565_calcFileSize() to stream pixel data after the header.
+  */
+int BMP_RGB565_initHeader(uint8_t *pHeader, uint32_t width, uint32_t height)
+{
+    uint32_t data_size = BMP_RGB565_calcFileSize(width, height);
+    uint32_t image_size = data_size - AllHeaderOffset;
+
+    if (pHeader == NULL || data_size == 0)
+        return -1;
+
     // Set header's default values
-    uint8_t *tmp = pbmp;
+    uint8_t *tmp = pHeader;
     *(tmp  +  0) = 'B';                                        // 'B' : Magic number
     *(tmp  +  1) = 'M';                                        // 'M' : Magic number
     BMP_RGB565_write_uint32_t(data_size        , tmp + 0x02);  // File Size
@@ -203,8 +392,7 @@ uint8_t *BMP_RGB565_create(uint32_t width, uint32_t height)
     BMP_RGB565_write_uint32_t( 0x000007E0      , tmp + 0x04);  // green
     BMP_RGB565_write_uint32_t( 0x0000001F      , tmp + 0x08);  // blue
     BMP_RGB565_write_uint32_t( 0x00000000      , tmp + 0x0C);  // reserved
-
-    return pbmp;
+    return 0;
 }
 
 /**
@@ -232,10 +420,12 @@ uint32_t BMP_RGB565_getWidth(uint8_t *pbmp)
   * @brief  Get height in pixel of a image.
   * @param  pbmp pointer to a image
   * @retval height [pixel]
+  * @detail A negative height in the header (top-down image) is returned as its absolute value.
   */
 uint32_t BMP_RGB565_getHeight(uint8_t *pbmp)
 {
-    return BMP_RGB565_read_uint32_t(pbmp + BMP_RGB565_FILE_HEADER_SIZE + 0x08);
+    int32_t height = (int32_t)BMP_RGB565_read_uint32_t(pbmp + BMP_RGB565_FILE_HEADER_SIZE + 0x08);
+    return (height < 0) ? (uint32_t)(-(int64_t)height) : (uint32_t)height;
 }
 
 /**
@@ -280,16 +470,7 @@ uint32_t BMP_RGB565_getOffset(uint8_t *pbmp)
   */
 void BMP_RGB565_setPixelRGB(uint8_t *pbmp, uint32_t x, uint32_t y, uint8_t r, uint8_t g, uint8_t b)
 {
-    uint32_t width  = BMP_RGB565_getWidth (pbmp);
-    uint32_t height = BMP_RGB565_getHeight (pbmp);
-
-    if(pbmp == NULL || x >= width || y >= height)
-        return;
-
-    uint32_t bytes_per_row = BMP_RGB565_getBytesPerRow(width);
-    uint16_t col = convertRGBtoRGB565(r, g, b);
-
-    BMP_RGB565_write_uint16_t( col, pbmp + AllHeaderOffset + bytes_per_row * (height - y - 1) + (x << 1));
+    BMP_RGB565_setPixel565(pbmp, x, y, convertRGBtoRGB565(r, g, b));
 }
 
 /**
@@ -304,14 +485,10 @@ void BMP_RGB565_setPixelRGB(uint8_t *pbmp, uint32_t x, uint32_t y, uint8_t r, ui
   */
 void BMP_RGB565_getPixelRGB(uint8_t *pbmp, uint32_t x, uint32_t y, uint8_t *r, uint8_t *g, uint8_t *b)
 {
-    uint32_t width  = BMP_RGB565_getWidth(pbmp);
-    uint32_t height = BMP_RGB565_getHeight(pbmp);
-
-    if(pbmp == NULL || x >= width || y >= height)
+    if(!BMP_RGB565_is565(pbmp) || x >= BMP_RGB565_getWidth(pbmp) || y >= BMP_RGB565_getHeight(pbmp))
         return;
 
-    uint32_t bytes_per_row = BMP_RGB565_getBytesPerRow(width);
-    uint16_t col = BMP_RGB565_read_uint16_t(pbmp + AllHeaderOffset + bytes_per_row * (height - y - 1) + (x << 1));
+    uint16_t col = BMP_RGB565_read_uint16_t(BMP_RGB565_getRowAddr(pbmp, y) + (x << 1));
     *r = (uint8_t)(col >> 11) << 3; if(*r == 0xF8) *r = 0xFF;
     *g = (uint8_t)(col >>  5) << 2; if(*g == 0xFC) *g = 0xFF;
     *b = (uint8_t) col        << 3; if(*b == 0xF8) *b = 0xFF;
@@ -329,43 +506,13 @@ void BMP_RGB565_getPixelRGB(uint8_t *pbmp, uint32_t x, uint32_t y, uint8_t *r, u
   * @param  g	Green value [0, 255] (Lower 2 bits are ignored)
   * @param  b	Blue  value [0, 255] (Lower 3 bits are ignored)
   * @retval None
-  * @detail Bresenham's line algorithm
-  *         ref : https://rosettacode.org/wiki/Bitmap/Bresenham%27s_line_algorithm#C
-  *         ref : https://ja.wikipedia.org/wiki/%E3%83%96%E3%83%AC%E3%82%BC%E3%83%B3%E3%83%8F%E3%83%A0%E3%81%AE%E3%82%A2%E3%83%AB%E3%82%B4%E3%83%AA%E3%82%BA%E3%83%A0#.E6.9C.80.E9.81.A9.E5.8C.96
+  * @detail See BMP_RGB565_drawLine565().
   */
 void BMP_RGB565_drawLineRGB(uint8_t *pbmp,
 		int32_t x0, int32_t y0, int32_t x1, int32_t y1,
         uint8_t r, uint8_t g, uint8_t b)
 {
-    uint32_t width  = BMP_RGB565_getWidth (pbmp);
-    uint32_t height = BMP_RGB565_getHeight (pbmp);
-
-    if(pbmp == NULL || x0 < 0 || x0 >= width || x1 < 0 || x1 >= width || y0 < 0 || y0 >= height || y1 < 0 || y1 >= height)
-        return;
-
-    uint32_t bytes_per_row = BMP_RGB565_getBytesPerRow(width);
-    uint16_t col = convertRGBtoRGB565(r, g, b);
-
-    int32_t dx = x1 - x0 > 0 ? x1 - x0 : x0 - x1;
-    int32_t sx = x0 < x1 ? 1 : -1;
-    int32_t dy = y1 - y0 > 0 ? y1 - y0 : y0 - y1;
-    int32_t sy = y0 < y1 ? 1 : -1;
-    int32_t err = dx - dy;
-    int32_t e2;
-
-    uint8_t *pbmp_data = pbmp + AllHeaderOffset;
-
-    for (;;)
-    {
-        BMP_RGB565_write_uint16_t( col, pbmp_data + bytes_per_row * (height - y0 - 1) + x0 * 2);
-
-        if (x0 == x1 && y0 == y1)
-            break;
-
-        e2 = 2*err;
-        if (e2 > -dy) {err -= dy;   x0 += sx;}
-        if (e2 <  dx) {err += dx;   y0 += sy;}
-    }
+    BMP_RGB565_drawLine565(pbmp, x0, y0, x1, y1, convertRGBtoRGB565(r, g, b));
 }
 
 
@@ -385,40 +532,7 @@ void BMP_RGB565_drawRectRGB(uint8_t *pbmp,
 		uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1,
         uint8_t r, uint8_t g, uint8_t b)
 {
-    uint32_t width = BMP_RGB565_getWidth(pbmp);
-    uint32_t height = BMP_RGB565_getHeight(pbmp);
-
-    if (pbmp == NULL || x0 >= width || x1 >= width || y0 >= height || y1 >= height)
-        return;
-
-    uint32_t swap;
-    if(x0 > x1)
-    {
-        swap = x0;
-        x0 = x1;
-        x1 = swap;
-    }
-    if (y0 > y1)
-    {
-        swap = y0;
-        x0 = y1;
-        y1 = swap;
-    }
-
-    uint32_t bytes_per_row = BMP_RGB565_getBytesPerRow(width);
-    uint16_t col = convertRGBtoRGB565(r, g, b);
-
-    uint8_t *pbmp_data = pbmp + AllHeaderOffset;
-
-    int32_t y_addr_start = bytes_per_row*(height - y0 - 1);
-    int32_t y_addr_end   = bytes_per_row*(height - y1 - 1);
-    int32_t x_addr_start = x0 * 2;
-    int32_t x_addr_end   = x1 * 2;
-    for(int32_t y_addr = y_addr_start; y_addr >= y_addr_end; y_addr -= bytes_per_row)
-    {
-        for(int32_t x_addr = x_addr_start; x_addr <= x_addr_end; x_addr += 2)
-            BMP_RGB565_write_uint16_t( col, pbmp_data + y_addr + x_addr);
-    }
+    BMP_RGB565_drawRect565(pbmp, x0, y0, x1, y1, convertRGBtoRGB565(r, g, b));
 }
 
 /**
@@ -431,10 +545,7 @@ void BMP_RGB565_drawRectRGB(uint8_t *pbmp,
   */
 void BMP_RGB565_fillRGB(uint8_t *pbmp, uint8_t r, uint8_t g, uint8_t b)
 {
-    if (pbmp == NULL)
-        return;
-
-    BMP_RGB565_drawRectRGB(pbmp, 0, 0, BMP_RGB565_getWidth(pbmp)-1, BMP_RGB565_getHeight(pbmp)-1, r, g, b);
+    BMP_RGB565_fill565(pbmp, convertRGBtoRGB565(r, g, b));
 }
 
 
@@ -455,37 +566,158 @@ void BMP_RGB565_fillRGB(uint8_t *pbmp, uint8_t r, uint8_t g, uint8_t b)
     uint32_t x_start, uint32_t y_start, 
     uint8_t r, uint8_t g, uint8_t b)
 {
-    size_t len = strlen(text);
-    int16_t imgWidth   = BMP_RGB565_getWidth(pbmp);
-    int16_t imgHeight  = BMP_RGB565_getHeight(pbmp);
-    int16_t x, y;
-    int bytesPerChar = font.char_width / 8;
-    if(font.char_width % 8 > 0)
-        bytesPerChar++;
+    BMP_RGB565_drawText565(pbmp, text, font, x_start, y_start, convertRGBtoRGB565(r, g, b));
+}
 
-    for(int i = 0; i < len; i++)
-    {
-        char c = *(text + i);
 
-        for(int16_t yTxt = 0; yTxt < font.char_height; yTxt++)
-        {
-            y = y_start + yTxt;
-            if(y >= imgHeight)
-                return;
-            for(int16_t xTxt = 0; xTxt < font.char_width; xTxt++)
-            {
-                x = x_start + i * font.char_width + xTxt;
-                if(x >= imgWidth)
-                    break;
+///// Packed RGB565 color functions
+/**
+  * @brief  Get a pointer to the pixels of a row.
+  * @param  pbmp pointer to a image
+  * @param  y	y of a image(Range:[0,height-1]) [pixel]
+  * @retval pointer to the first pixel of row y. When error, return NULL
+  * @detail The row order (bottom-up or top-down) of the image is taken into account,
+  *         so `BMP_RGB565_getRow(pbmp, y)[x]` is the pixel (x, y).
+  *         The pointer is 2-byte aligned. Pixels are stored in little-endian order.
+  */
+uint16_t *BMP_RGB565_getRow(uint8_t *pbmp, uint32_t y)
+{
+    if(!BMP_RGB565_is565(pbmp) || y >= BMP_RGB565_getHeight(pbmp))
+        return NULL;
 
-                uint8_t buf = *(font.p + c * bytesPerChar * font.char_height
-                            + yTxt * bytesPerChar
-                            + (bytesPerChar - 1) - (xTxt >> 3));
-                if(buf & (0x80 >> (xTxt & 0x07)))
-                    BMP_RGB565_setPixelRGB(pbmp, x, y, r, g, b);
-            }
-        }
-    }
+    return (uint16_t *)BMP_RGB565_getRowAddr(pbmp, y);
+}
+
+/**
+  * @brief  Draw a RGB565 color on a specified pixel.
+  * @param  pbmp pointer to a image
+  * @param  x	x of a image(Range:[0,width-1] ) [pixel]
+  * @param  y	y of a image(Range:[0,height-1]) [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  */
+void BMP_RGB565_setPixel565(uint8_t *pbmp, uint32_t x, uint32_t y, uint16_t col)
+{
+    if(!BMP_RGB565_is565(pbmp) || x >= BMP_RGB565_getWidth(pbmp) || y >= BMP_RGB565_getHeight(pbmp))
+        return;
+
+    BMP_RGB565_write_uint16_t(col, BMP_RGB565_getRowAddr(pbmp, y) + (x << 1));
+}
+
+/**
+  * @brief  Get a RGB565 color on a specified pixel.
+  * @param  pbmp pointer to a image
+  * @param  x	x of a image(Range:[0,width-1] ) [pixel]
+  * @param  y	y of a image(Range:[0,height-1]) [pixel]
+  * @retval RGB565 color. When out of range, return 0
+  */
+uint16_t BMP_RGB565_getPixel565(uint8_t *pbmp, uint32_t x, uint32_t y)
+{
+    if(!BMP_RGB565_is565(pbmp) || x >= BMP_RGB565_getWidth(pbmp) || y >= BMP_RGB565_getHeight(pbmp))
+        return 0;
+
+    return BMP_RGB565_read_uint16_t(BMP_RGB565_getRowAddr(pbmp, y) + (x << 1));
+}
+
+/**
+  * @brief  Draws a straight line in a specified RGB565 color.
+  * @param  pbmp pointer to a image
+  * @param  x0	Start x position of a line(Range:[0,width-1] ) [pixel]
+  * @param  y0  Start y position of a line(Range:[0,width-1] ) [pixel]
+  * @param  x1	End   x position of a line(Range:[0,width-1] ) [pixel]
+  * @param  y1  End   y position of a line(Range:[0,width-1] ) [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  * @detail Bresenham's line algorithm
+  *         ref : https://rosettacode.org/wiki/Bitmap/Bresenham%27s_line_algorithm#C
+  *         ref : https://ja.wikipedia.org/wiki/%E3%83%96%E3%83%AC%E3%82%BC%E3%83%B3%E3%83%8F%E3%83%A0%E3%81%AE%E3%82%A2%E3%83%AB%E3%82%B4%E3%83%AA%E3%82%BA%E3%83%A0#.E6.9C.80.E9.81.A9.E5.8C.96
+  */
+void BMP_RGB565_drawLine565(uint8_t *pbmp,
+		int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+        uint16_t col)
+{
+    if(pbmp == NULL)
+        return;
+
+    uint32_t width  = BMP_RGB565_getWidth (pbmp);
+    uint32_t height = BMP_RGB565_getHeight (pbmp);
+
+    if(x0 < 0 || (uint32_t)x0 >= width || x1 < 0 || (uint32_t)x1 >= width || y0 < 0 || (uint32_t)y0 >= height || y1 < 0 || (uint32_t)y1 >= height)
+        return;
+
+    BMP_RGB565_view_st view;
+    if(BMP_RGB565_viewInit(&view, pbmp, 0, 0, width, height) != 0)
+        return;
+    BMP_RGB565_viewDrawLine565(&view, x0, y0, x1, y1, col);
+}
+
+/**
+  * @brief  Draws a Rectangle in a specified RGB565 color.
+  * @param  pbmp pointer to a image
+  * @param  x0	Start x position of a line(Range:[0,width-1] ) [pixel]
+  * @param  y0  Start y position of a line(Range:[0,width-1] ) [pixel]
+  * @param  x1	End   x position of a line(Range:[0,width-1] ) [pixel]
+  * @param  y1  End   y position of a line(Range:[0,width-1] ) [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  */
+void BMP_RGB565_drawRect565(uint8_t *pbmp,
+		uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1,
+        uint16_t col)
+{
+    if (pbmp == NULL)
+        return;
+
+    uint32_t width = BMP_RGB565_getWidth(pbmp);
+    uint32_t height = BMP_RGB565_getHeight(pbmp);
+
+    if (x0 >= width || x1 >= width || y0 >= height || y1 >= height)
+        return;
+
+    BMP_RGB565_view_st view;
+    if (BMP_RGB565_viewInit(&view, pbmp, 0, 0, width, height) != 0)
+        return;
+    BMP_RGB565_viewDrawRect565(&view, (int32_t)x0, (int32_t)y0, (int32_t)x1, (int32_t)y1, col);
+}
+
+/**
+  * @brief  Fill image in a specified RGB565 color.
+  * @param  pbmp pointer to a image
+  * @param  col	RGB565 color
+  * @retval None
+  */
+void BMP_RGB565_fill565(uint8_t *pbmp, uint16_t col)
+{
+    if (pbmp == NULL)
+        return;
+
+    BMP_RGB565_drawRect565(pbmp, 0, 0, BMP_RGB565_getWidth(pbmp)-1, BMP_RGB565_getHeight(pbmp)-1, col);
+}
+
+/**
+  * @brief  Draws text in a specified RGB565 color.
+  * @param  pbmp pointer to a image
+  * @param  text pointer to text to write
+  * @param  font font
+  * @param  x_start	Start x position of characters (Range:[0,width-1] ) [pixel]
+  * @param  y_start Start y position of characters (Range:[0,width-1] ) [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  * @detail The fonts to be used must be enabled in `bmp_rgb565.h`.
+  */
+void BMP_RGB565_drawText565(uint8_t *pbmp, const char *text, BMP_RGB565_font_st font,
+    uint32_t x_start, uint32_t y_start,
+    uint16_t col)
+{
+    BMP_RGB565_view_st view;
+
+    if(pbmp == NULL || text == NULL)
+        return;
+    if(x_start >= BMP_RGB565_getWidth(pbmp) || y_start >= BMP_RGB565_getHeight(pbmp))
+        return;
+
+    if(BMP_RGB565_viewInit(&view, pbmp, 0, 0, BMP_RGB565_getWidth(pbmp), BMP_RGB565_getHeight(pbmp)) == 0)
+        BMP_RGB565_viewDrawText565(&view, text, font, (int32_t)x_start, (int32_t)y_start, col);
 }
 
 
@@ -496,7 +728,7 @@ void BMP_RGB565_fillRGB(uint8_t *pbmp, uint8_t r, uint8_t g, uint8_t b)
   */
 uint8_t *BMP_RGB565_copy(uint8_t *pbmp)
 {
-    uint8_t *pbmpDst = BMP_RGB565_create(BMP_RGB565_getWidth(pbmp), BMP_RGB565_getHeight(pbmp));
+    uint8_t *pbmpDst = (uint8_t *)bmp_rgb565_malloc(sizeof(uint8_t) * BMP_RGB565_getFileSize(pbmp));
     if(pbmpDst == NULL)
         return NULL;
     memcpy(pbmpDst, pbmp, BMP_RGB565_getFileSize(pbmp));
@@ -514,137 +746,1940 @@ uint8_t *BMP_RGB565_copy(uint8_t *pbmp)
   */
 uint8_t *BMP_RGB565_resize_bicubic(uint8_t *pbmpSrc, uint32_t width, uint32_t height)
 {
-	uint8_t *pbmpDst;
-	int src_x_size, src_y_size, dst_x_size, dst_y_size;
-	float C[4][3];
-	float d0[3], d2[3], d3[3], a0[3], a1, a2, a3;
-	int x, y;
-	float dx, dy;
-	float tx, ty;
-    uint8_t rgb1[3], rgb2[3], rgb_out[3];
+    BMP_RGB565_view_st src, dst;
 
-	pbmpDst = BMP_RGB565_create(width, height);
-	if(pbmpDst == NULL)
-		return NULL;
-
-    for (int i = 0; i < 4; i++)
-    for (int j = 0; j < 3; j++)
-        C[i][j] = 0.0f;
+    if(pbmpSrc == NULL || BMP_RGB565_viewInit(&src, pbmpSrc, 0, 0, BMP_RGB565_getWidth(pbmpSrc), BMP_RGB565_getHeight(pbmpSrc)) != 0)
+        return NULL;
 
-	src_x_size = BMP_RGB565_getWidth (pbmpSrc);
-	src_y_size = BMP_RGB565_getHeight(pbmpSrc);
-	dst_x_size = width;
-	dst_y_size = height;
+    uint8_t *pbmpDst = BMP_RGB565_create(width, height);
+    if(pbmpDst == NULL)
+        return NULL;
 
-	tx = (float)src_x_size / dst_x_size;
-	ty = (float)src_y_size / dst_y_size;
+    // Nothing to resample into an empty image
+    if(BMP_RGB565_viewInit(&dst, pbmpDst, 0, 0, width, height) == 0)
+        BMP_RGB565_viewResizeBicubic(&src, &dst);
+    return pbmpDst;
+}
 
-	for (int dstCol = 0; dstCol < dst_y_size; dstCol++)
-	{
-		for (int dstRow = 0; dstRow < dst_x_size; dstRow++)
-		{
-			x = (int) (tx * dstRow);
-			y = (int) (ty * dstCol);
 
-			dx = tx * dstRow - x;
-			dy = ty * dstCol - y;
+///// Packed font functions
+/**
+  * @brief  Load a packed font from a blob.
+  * @param  pSrc pointer to a packed font (in memory or a mmap'd file)
+  * @param  size size of the blob [byte]
+  * @param  font pointer to a font to initialize
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail The blob is not copied and must stay valid while the font is used.
+  *         Blobs are created by BMP_RGB565_packFont() (see tools/bmp_rgb565_fontconv.c).
+  *         Layout (little-endian):
+  *           0x00 'B','F','N','T'
+  *           0x04 version (1), char width, char height, reserved
+  *           0x08 first character code (uint16_t), number of codes (uint16_t)
+  *           0x0C glyph offset index (uint32_t x number of codes, 0xFFFFFFFF: no glyph)
+  *           ...  glyph data, 1bpp, rows packed MSB first, ceil(width*height/8) bytes per glyph
+  */
+int BMP_RGB565_loadPackedFont(const uint8_t *pSrc, size_t size, BMP_RGB565_packedFont_st *font)
+{
+    if (pSrc == NULL || font == NULL || size < BMP_RGB565_PACKED_FONT_HEADER_SIZE)
+        return -1;
+    if (memcmp(pSrc, "BFNT", 4) != 0 || pSrc[4] != 1 || pSrc[5] == 0 || pSrc[6] == 0)
+        return -1;
 
-			for (int i = 0; i < 3; i++)
-			{
-				for (int j = 0; j <= 3; j++)
-				{
-					BMP_RGB565_getPixelRGB(pbmpSrc, RANGE((x - 1) + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), &rgb1[0], &rgb1[1], &rgb1[2]);
-					BMP_RGB565_getPixelRGB(pbmpSrc, RANGE((x)     + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), &rgb2[0], &rgb2[1], &rgb2[2]);
-					for(int rgb_i = 0; rgb_i < 3; rgb_i++)
-						d0[rgb_i] = rgb1[rgb_i] - rgb2[rgb_i];
+    uint32_t count = BMP_RGB565_read_uint16_t((uint8_t *)pSrc + 0x0A);
+    size_t glyph_offset = BMP_RGB565_PACKED_FONT_HEADER_SIZE + (size_t)count * 4;
+    size_t glyph_size = ((size_t)pSrc[5] * pSrc[6] + 7) / 8;
+    if (size < glyph_offset)
+        return -1;
 
-					BMP_RGB565_getPixelRGB(pbmpSrc, RANGE((x + 1) + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), &rgb1[0], &rgb1[1], &rgb1[2]);
-					BMP_RGB565_getPixelRGB(pbmpSrc, RANGE((x)     + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), &rgb2[0], &rgb2[1], &rgb2[2]);
+    // Every glyph referenced by the index must be inside the blob
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t offset = BMP_RGB565_read_uint32_t((uint8_t *)pSrc + BMP_RGB565_PACKED_FONT_HEADER_SIZE + i * 4);
+        if (offset != 0xFFFFFFFF && (offset > size - glyph_offset || size - glyph_offset - offset < glyph_size))
+            return -1;
+    }
+
+    font->p           = pSrc;
+    font->char_width  = pSrc[5];
+    font->char_height = pSrc[6];
+    font->first       = BMP_RGB565_read_uint16_t((uint8_t *)pSrc + 0x08);
+    font->count       = (uint16_t)count;
+    return 0;
+}
+
+/**
+  * @brief  Convert a font table to a packed font.
+  * @param  font   font
+  * @param  first  first character code of the range
+  * @param  last   last  character code of the range
+  * @param  subset characters to keep in the range. NULL: all characters
+  * @param  pDst   pointer to a destination buffer. NULL: only calculate the size
+  * @param  dstSize size of the destination buffer [byte]
+  * @retval size of the packed font [byte]. When error, return 0
+  */
+size_t BMP_RGB565_packFont(BMP_RGB565_font_st font, uint8_t first, uint8_t last, const char *subset, uint8_t *pDst, size_t dstSize)
+{
+    if (font.p == NULL || font.char_width <= 0 || font.char_height <= 0 || first > last)
+        return 0;
+
+    uint32_t count = (uint32_t)last - first + 1;
+    uint32_t glyphs = 0;
+    size_t glyph_size = ((size_t)font.char_width * font.char_height + 7) / 8;
+
+    for (uint32_t c = first; c <= last; c++)
+        if (subset == NULL || (c != 0 && strchr(subset, (char)c) != NULL))   // strchr() matches '\0' of subset
+            glyphs++;
+
+    size_t total = BMP_RGB565_PACKED_FONT_HEADER_SIZE + (size_t)count * 4 + glyphs * glyph_size;
+    if (pDst == NULL)
+        return total;
+    if (dstSize < total)
+        return 0;
+
+    memset(pDst, 0, total);
+    memcpy(pDst, "BFNT", 4);
+    pDst[4] = 1;
+    pDst[5] = (uint8_t)font.char_width;
+    pDst[6] = (uint8_t)font.char_height;
+    BMP_RGB565_write_uint16_t(first, pDst + 0x08);
+    BMP_RGB565_write_uint16_t((uint16_t)count, pDst + 0x0A);
+
+    int bytesPerChar = font.char_width / 8;
+    if (font.char_width % 8 > 0)
+        bytesPerChar++;
+
+    uint8_t *pIndex = pDst + BMP_RGB565_PACKED_FONT_HEADER_SIZE;
+    uint8_t *pGlyphs = pIndex + count * 4;
+    uint32_t offset = 0;
+
+    for (uint32_t c = first; c <= last; c++, pIndex += 4)
+    {
+        if (subset != NULL && (c == 0 || strchr(subset, (char)c) == NULL))
+        {
+            BMP_RGB565_write_uint32_t(0xFFFFFFFF, pIndex);
+            continue;
+        }
+        BMP_RGB565_write_uint32_t(offset, pIndex);
+
+        uint32_t bit = 0;
+        for (int yTxt = 0; yTxt < font.char_height; yTxt++)
+        {
+            for (int xTxt = 0; xTxt < font.char_width; xTxt++, bit++)
+            {
+                uint8_t buf = *(font.p + c * bytesPerChar * font.char_height
+                            + yTxt * bytesPerChar
+                            + (bytesPerChar - 1) - (xTxt >> 3));
+                if (buf & (0x80 >> (xTxt & 0x07)))
+                    pGlyphs[offset + (bit >> 3)] |= 0x80 >> (bit & 0x07);
+            }
+        }
+        offset += glyph_size;
+    }
+    return total;
+}
+
+/**
+  * @brief  Draws text with a packed font in a specified RGB565 color.
+  * @param  pbmp pointer to a image
+  * @param  text pointer to text to write
+  * @param  font pointer to a packed font
+  * @param  x_start	Start x position of characters (Range:[0,width-1] ) [pixel]
+  * @param  y_start Start y position of characters (Range:[0,width-1] ) [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  * @detail Characters without a glyph are left blank.
+  */
+void BMP_RGB565_drawTextPacked565(uint8_t *pbmp, const char *text, const BMP_RGB565_packedFont_st *font,
+    uint32_t x_start, uint32_t y_start,
+    uint16_t col)
+{
+    if(!BMP_RGB565_is565(pbmp) || text == NULL || font == NULL || font->p == NULL)
+        return;
+
+    size_t len = strlen(text);
+    uint32_t imgWidth   = BMP_RGB565_getWidth(pbmp);
+    uint32_t imgHeight  = BMP_RGB565_getHeight(pbmp);
+    const uint8_t *pIndex  = font->p + BMP_RGB565_PACKED_FONT_HEADER_SIZE;
+    const uint8_t *pGlyphs = pIndex + (size_t)font->count * 4;
+
+    for(size_t i = 0; i < len; i++)
+    {
+        uint32_t code = (uint8_t)*(text + i);
+        if(code < font->first || code - font->first >= font->count)
+            continue;
+
+        uint32_t offset = BMP_RGB565_read_uint32_t((uint8_t *)pIndex + (code - font->first) * 4);
+        if(offset == 0xFFFFFFFF)
+            continue;
+
+        const uint8_t *pGlyph = pGlyphs + offset;
+        uint32_t bit = 0;
+        for(uint32_t yTxt = 0; yTxt < font->char_height; yTxt++, bit += font->char_width)
+        {
+            uint32_t y = y_start + yTxt;
+            if(y >= imgHeight)
+                return;
+            uint16_t *row = (uint16_t *)BMP_RGB565_getRowAddr(pbmp, y);
+            for(uint32_t xTxt = 0; xTxt < font->char_width; xTxt++)
+            {
+                uint32_t x = x_start + i * font->char_width + xTxt;
+                if(x >= imgWidth)
+                    break;
+
+                uint32_t b = bit + xTxt;
+                if(pGlyph[b >> 3] & (0x80 >> (b & 0x07)))
+                    BMP_RGB565_put565(row, x, col);
+            }
+        }
+    }
+}
+
+/**
+  * @brief  Measure the size of text without drawing it.
+  * @param  text   pointer to text
+  * @param  font   font
+  * @param  width  pointer to a width  of the text [pixel]
+  * @param  height pointer to a height of the text [pixel]
+  * @retval None
+  */
+void BMP_RGB565_measureText(const char *text, BMP_RGB565_font_st font, uint32_t *width, uint32_t *height)
+{
+    size_t len = (text == NULL) ? 0 : strlen(text);
+
+    if (width != NULL)
+        *width  = (uint32_t)len * (uint32_t)font.char_width;
+    if (height != NULL)
+        *height = (len == 0) ? 0 : (uint32_t)font.char_height;
+}
+
+/**
+  * @brief  Measure the size of text drawn with a packed font.
+  * @param  text   pointer to text
+  * @param  font   pointer to a packed font
+  * @param  width  pointer to a width  of the text [pixel]
+  * @param  height pointer to a height of the text [pixel]
+  * @retval None
+  */
+void BMP_RGB565_measureTextPacked(const char *text, const BMP_RGB565_packedFont_st *font, uint32_t *width, uint32_t *height)
+{
+    size_t len = (text == NULL || font == NULL) ? 0 : strlen(text);
+
+    if (width != NULL)
+        *width  = (len == 0) ? 0 : (uint32_t)len * font->char_width;
+    if (height != NULL)
+        *height = (len == 0) ? 0 : font->char_height;
+}
+
+
+///// Orientation functions
+/**
+  * @brief  Rotate image 90 degrees clockwise.
+  * @param  pbmpSrc pointer to a source image
+  * @retval pointer to the created image (width and height are swapped). When error, return NULL
+  */
+uint8_t *BMP_RGB565_rotate90(uint8_t *pbmpSrc)
+{
+    return BMP_RGB565_transposeTiled(pbmpSrc, false, true);
+}
+
+/**
+  * @brief  Rotate image 270 degrees clockwise (90 degrees counterclockwise).
+  * @param  pbmpSrc pointer to a source image
+  * @retval pointer to the created image (width and height are swapped). When error, return NULL
+  */
+uint8_t *BMP_RGB565_rotate270(uint8_t *pbmpSrc)
+{
+    return BMP_RGB565_transposeTiled(pbmpSrc, true, false);
+}
+
+/**
+  * @brief  Transpose image (mirror along the main diagonal).
+  * @param  pbmpSrc pointer to a source image
+  * @retval pointer to the created image (width and height are swapped). When error, return NULL
+  */
+uint8_t *BMP_RGB565_transpose(uint8_t *pbmpSrc)
+{
+    return BMP_RGB565_transposeTiled(pbmpSrc, false, false);
+}
+
+/**
+  * @brief  Rotate image 180 degrees in place.
+  * @param  pbmp pointer to a image
+  * @retval None
+  */
+void BMP_RGB565_rotate180(uint8_t *pbmp)
+{
+    if(!BMP_RGB565_is565(pbmp))
+        return;
+
+    uint32_t width  = BMP_RGB565_getWidth(pbmp);
+    uint32_t height = BMP_RGB565_getHeight(pbmp);
+
+    for(uint32_t y = 0; y < height / 2; y++)
+    {
+        uint16_t *top    = BMP_RGB565_getRow(pbmp, y);
+        uint16_t *bottom = BMP_RGB565_getRow(pbmp, height - y - 1);
+        for(uint32_t x = 0; x < width; x++)
+        {
+            uint16_t tmp = top[x];
+            top[x] = bottom[width - x - 1];
+            bottom[width - x - 1] = tmp;
+        }
+    }
+    if(height & 0x00000001)
+        BMP_RGB565_reverseRow(BMP_RGB565_getRow(pbmp, height / 2), width);
+}
+
+/**
+  * @brief  Mirror image horizontally (left <-> right) in place.
+  * @param  pbmp pointer to a image
+  * @retval None
+  */
+void BMP_RGB565_flipHorizontal(uint8_t *pbmp)
+{
+    if(!BMP_RGB565_is565(pbmp))
+        return;
+
+    uint32_t width  = BMP_RGB565_getWidth(pbmp);
+    uint32_t height = BMP_RGB565_getHeight(pbmp);
+
+    for(uint32_t y = 0; y < height; y++)
+        BMP_RGB565_reverseRow(BMP_RGB565_getRow(pbmp, y), width);
+}
+
+/**
+  * @brief  Mirror image vertically (top <-> bottom) in place.
+  * @param  pbmp pointer to a image
+  * @retval None
+  */
+void BMP_RGB565_flipVertical(uint8_t *pbmp)
+{
+    if(!BMP_RGB565_is565(pbmp))
+        return;
+
+    uint32_t width  = BMP_RGB565_getWidth(pbmp);
+    uint32_t height = BMP_RGB565_getHeight(pbmp);
+
+    for(uint32_t y = 0; y < height / 2; y++)
+    {
+        uint16_t *top    = BMP_RGB565_getRow(pbmp, y);
+        uint16_t *bottom = BMP_RGB565_getRow(pbmp, height - y - 1);
+        for(uint32_t x = 0; x < width; x++)
+        {
+            uint16_t tmp = top[x];
+            top[x] = bottom[x];
+            bottom[x] = tmp;
+        }
+    }
+}
+
+
+///// Scroll functions
+/**
+  * @brief  Scroll a rectangular region of an image in a specified RGB color.
+  * @param  pbmp pointer to a image
+  * @param  x0	Start x position of a region(Range:[0,width-1] ) [pixel]
+  * @param  y0  Start y position of a region(Range:[0,height-1]) [pixel]
+  * @param  x1	End   x position of a region(Range:[0,width-1] ) [pixel]
+  * @param  y1  End   y position of a region(Range:[0,height-1]) [pixel]
+  * @param  dx	Horizontal shift (positive: right) [pixel]
+  * @param  dy	Vertical   shift (positive: down ) [pixel]
+  * @param  r	Red   value of exposed area [0, 255] (Lower 3 bits are ignored)
+  * @param  g	Green value of exposed area [0, 255] (Lower 2 bits are ignored)
+  * @param  b	Blue  value of exposed area [0, 255] (Lower 3 bits are ignored)
+  * @retval None
+  */
+void BMP_RGB565_scrollRGB(uint8_t *pbmp,
+		uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, int32_t dx, int32_t dy,
+        uint8_t r, uint8_t g, uint8_t b)
+{
+    BMP_RGB565_scroll565(pbmp, x0, y0, x1, y1, dx, dy, convertRGBtoRGB565(r, g, b));
+}
+
+/**
+  * @brief  Scroll a rectangular region of an image in a specified RGB565 color.
+  * @param  pbmp pointer to a image
+  * @param  x0	Start x position of a region(Range:[0,width-1] ) [pixel]
+  * @param  y0  Start y position of a region(Range:[0,height-1]) [pixel]
+  * @param  x1	End   x position of a region(Range:[0,width-1] ) [pixel]
+  * @param  y1  End   y position of a region(Range:[0,height-1]) [pixel]
+  * @param  dx	Horizontal shift (positive: right) [pixel]
+  * @param  dy	Vertical   shift (positive: down ) [pixel]
+  * @param  col	RGB565 color of exposed area
+  * @retval None
+  * @detail Pixels shifted out of the region are discarded.
+  *         Each row is moved with a single memmove().
+  */
+void BMP_RGB565_scroll565(uint8_t *pbmp,
+		uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, int32_t dx, int32_t dy,
+        uint16_t col)
+{
+    if (!BMP_RGB565_is565(pbmp))
+        return;
+
+    uint32_t width = BMP_RGB565_getWidth(pbmp);
+    uint32_t height = BMP_RGB565_getHeight(pbmp);
+
+    if (x0 >= width || x1 >= width || y0 >= height || y1 >= height)
+        return;
+
+    uint32_t swap;
+    if(x0 > x1)
+    {
+        swap = x0;
+        x0 = x1;
+        x1 = swap;
+    }
+    if (y0 > y1)
+    {
+        swap = y0;
+        y0 = y1;
+        y1 = swap;
+    }
+
+    uint32_t region_width  = x1 - x0 + 1;
+    uint32_t region_height = y1 - y0 + 1;
+    uint32_t abs_dx = (dx < 0) ? (uint32_t)(-(int64_t)dx) : (uint32_t)dx;
+    uint32_t abs_dy = (dy < 0) ? (uint32_t)(-(int64_t)dy) : (uint32_t)dy;
+
+    if (abs_dx >= region_width || abs_dy >= region_height)
+    {
+        BMP_RGB565_drawRect565(pbmp, x0, y0, x1, y1, col);
+        return;
+    }
+    if (dx == 0 && dy == 0)
+        return;
+
+    uint32_t keep_width = region_width - abs_dx;
+    uint32_t src_x  = (dx < 0) ? x0 + abs_dx : x0;
+    uint32_t dst_x  = (dx < 0) ? x0 : x0 + abs_dx;
+    uint32_t fill_x = (dx < 0) ? x0 + keep_width : x0;
+
+    // Walk rows against the shift direction so that no source row is overwritten before it is read
+    for(uint32_t i = 0; i < region_height - abs_dy; i++)
+    {
+        uint32_t y = (dy > 0) ? y1 - i : y0 + i;
+        uint16_t *dst_row = BMP_RGB565_getRow(pbmp, y);
+        uint16_t *src_row = BMP_RGB565_getRow(pbmp, (dy > 0) ? y - abs_dy : y + abs_dy);
+
+        memmove(dst_row + dst_x, src_row + src_x, keep_width * sizeof(uint16_t));
+        for(uint32_t x = fill_x; x < fill_x + abs_dx; x++)
+            BMP_RGB565_put565(dst_row, x, col);
+    }
+
+    // Exposed rows
+    if (abs_dy > 0)
+    {
+        uint32_t fill_y = (dy > 0) ? y0 : y1 - abs_dy + 1;
+        BMP_RGB565_drawRect565(pbmp, x0, fill_y, x1, fill_y + abs_dy - 1, col);
+    }
+}
+
+/**
+  * @brief  Attach a ring buffer (virtual origin) to an image.
+  * @param  ring pointer to a ring buffer
+  * @param  pbmp pointer to a image
+  * @retval None
+  * @detail Logical pixel (x, y) of the ring is stored at physical pixel
+  *         ((x + x_origin) % width, (y + y_origin) % height) of the image,
+  *         so scrolling the whole image only moves the origin.
+  *         Call BMP_RGB565_ringFlatten() before exporting the image.
+  *         When pbmp is not a RGB565 image, the ring is attached to no image (pbmp is NULL).
+  */
+void BMP_RGB565_ringInit(BMP_RGB565_ring_st *ring, uint8_t *pbmp)
+{
+    if (ring == NULL)
+        return;
+
+    ring->pbmp = BMP_RGB565_is565(pbmp) ? pbmp : NULL;
+    ring->x_origin = 0;
+    ring->y_origin = 0;
+}
+
+/**
+  * @brief  Scroll the whole ring buffer in a specified RGB565 color.
+  * @param  ring pointer to a ring buffer
+  * @param  dx	Horizontal shift (positive: right) [pixel]
+  * @param  dy	Vertical   shift (positive: down ) [pixel]
+  * @param  col	RGB565 color of exposed area
+  * @retval None
+  * @detail Only the origin is moved and the exposed columns/rows are filled.
+  */
+void BMP_RGB565_ringScroll565(BMP_RGB565_ring_st *ring, int32_t dx, int32_t dy, uint16_t col)
+{
+    if (ring == NULL || ring->pbmp == NULL)
+        return;
+
+    uint32_t width  = BMP_RGB565_getWidth(ring->pbmp);
+    uint32_t height = BMP_RGB565_getHeight(ring->pbmp);
+    uint32_t abs_dx = (dx < 0) ? (uint32_t)(-(int64_t)dx) : (uint32_t)dx;
+    uint32_t abs_dy = (dy < 0) ? (uint32_t)(-(int64_t)dy) : (uint32_t)dy;
+
+    if (width == 0 || height == 0)
+        return;
+    if (abs_dx >= width || abs_dy >= height)
+    {
+        BMP_RGB565_fill565(ring->pbmp, col);
+        ring->x_origin = 0;
+        ring->y_origin = 0;
+        return;
+    }
+
+    // Content moves by (dx, dy) while the physical pixels stay: origin moves by (-dx, -dy)
+    ring->x_origin = (dx > 0) ? (ring->x_origin + width  - abs_dx) % width  : (ring->x_origin + abs_dx) % width;
+    ring->y_origin = (dy > 0) ? (ring->y_origin + height - abs_dy) % height : (ring->y_origin + abs_dy) % height;
+
+    // Exposed columns
+    uint32_t fill_x = (dx > 0) ? 0 : width - abs_dx;
+    for (uint32_t y = 0; y < height; y++)
+    {
+        uint16_t *row = BMP_RGB565_getRow(ring->pbmp, y);
+        for (uint32_t x = fill_x; x < fill_x + abs_dx; x++)
+            BMP_RGB565_put565(row, (x + ring->x_origin) % width, col);
+    }
+
+    // Exposed rows
+    uint32_t fill_y = (dy > 0) ? 0 : height - abs_dy;
+    for (uint32_t y = fill_y; y < fill_y + abs_dy; y++)
+    {
+        uint16_t *row = BMP_RGB565_ringGetRow(ring, y);
+        for (uint32_t x = 0; x < width; x++)
+            BMP_RGB565_put565(row, x, col);
+    }
+}
+
+/**
+  * @brief  Get a pointer to the pixels of a logical row of a ring buffer.
+  * @param  ring pointer to a ring buffer
+  * @param  y	logical y (Range:[0,height-1]) [pixel]
+  * @retval pointer to the physical row. When error, return NULL
+  * @detail Logical x is stored at index (x + ring->x_origin) % width of the returned row.
+  */
+uint16_t *BMP_RGB565_ringGetRow(BMP_RGB565_ring_st *ring, uint32_t y)
+{
+    if (ring == NULL || ring->pbmp == NULL)
+        return NULL;
+
+    uint32_t height = BMP_RGB565_getHeight(ring->pbmp);
+    if (y >= height)
+        return NULL;
+
+    return BMP_RGB565_getRow(ring->pbmp, (y + ring->y_origin) % height);
+}
+
+/**
+  * @brief  Draw a RGB565 color on a logical pixel of a ring buffer.
+  * @param  ring pointer to a ring buffer
+  * @param  x	logical x (Range:[0,width-1] ) [pixel]
+  * @param  y	logical y (Range:[0,height-1]) [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  */
+void BMP_RGB565_ringSetPixel565(BMP_RGB565_ring_st *ring, uint32_t x, uint32_t y, uint16_t col)
+{
+    uint16_t *row = BMP_RGB565_ringGetRow(ring, y);
+    uint32_t width;
+
+    if (row == NULL || x >= (width = BMP_RGB565_getWidth(ring->pbmp)))
+        return;
+
+    BMP_RGB565_put565(row, (x + ring->x_origin) % width, col);
+}
+
+/**
+  * @brief  Get a RGB565 color on a logical pixel of a ring buffer.
+  * @param  ring pointer to a ring buffer
+  * @param  x	logical x (Range:[0,width-1] ) [pixel]
+  * @param  y	logical y (Range:[0,height-1]) [pixel]
+  * @retval RGB565 color. When out of range, return 0
+  */
+uint16_t BMP_RGB565_ringGetPixel565(BMP_RGB565_ring_st *ring, uint32_t x, uint32_t y)
+{
+    uint16_t *row = BMP_RGB565_ringGetRow(ring, y);
+    uint32_t width;
+
+    if (row == NULL || x >= (width = BMP_RGB565_getWidth(ring->pbmp)))
+        return 0;
+
+    return BMP_RGB565_get565(row, (x + ring->x_origin) % width);
+}
+
+/**
+  * @brief  Move the pixels of a ring buffer so that the origin becomes (0, 0).
+  * @param  ring pointer to a ring buffer
+  * @retval None
+  * @detail After this call the image can be exported as a normal bitmap.
+  *         Rows and columns are rotated in place by three reversals.
+  */
+void BMP_RGB565_ringFlatten(BMP_RGB565_ring_st *ring)
+{
+    if (ring == NULL || ring->pbmp == NULL)
+        return;
+
+    uint32_t width  = BMP_RGB565_getWidth(ring->pbmp);
+    uint32_t height = BMP_RGB565_getHeight(ring->pbmp);
+
+    if (ring->x_origin != 0)
+    {
+        for (uint32_t y = 0; y < height; y++)
+        {
+            uint16_t *row = BMP_RGB565_getRow(ring->pbmp, y);
+            BMP_RGB565_reverseRow(row, ring->x_origin);
+            BMP_RGB565_reverseRow(row + ring->x_origin, width - ring->x_origin);
+            BMP_RGB565_reverseRow(row, width);
+        }
+    }
+    if (ring->y_origin != 0)
+    {
+        BMP_RGB565_reverseRows(ring->pbmp, 0, ring->y_origin);
+        BMP_RGB565_reverseRows(ring->pbmp, ring->y_origin, height);
+        BMP_RGB565_reverseRows(ring->pbmp, 0, height);
+    }
+    ring->x_origin = 0;
+    ring->y_origin = 0;
+}
+
+
+///// Support function
+/**
+  * @brief  Color scale function for thermography.
+  * @param  val    Value
+  * @param  maxVal Maximum value
+  * @param  minVal Minimum value
+  * @param  r	   Pointer to a red   value [0, 255]
+  * @param  g	   Pointer to a green value [0, 255]
+  * @param  b	   Pointer to a blue  value [0, 255]
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_colorScale(float val, float maxVal, float minVal, uint8_t *r, uint8_t *g, uint8_t *b)
+{
+    float ratio;	// 0 ~ 1
+    if (maxVal > minVal)
+    	ratio = (val - minVal) / (maxVal - minVal);
+    else {
+        //printf("Error: maxVal <= minVal\n");
+        return -1;
+    }
+
+    // with Black/White
+    int32_t ratio_buf = 6.0f * ratio;
+    uint8_t col_val = 127.5f * (cosf(6.0f * M_PI * ratio) + 1.0f);	// 127.5 means 255/2
+         if (ratio_buf >= 6) {*r = 255;           *g = 255;           *b = 255;         }   // White
+    else if (ratio_buf >= 5) {*r = 255;           *g = col_val;       *b = col_val;     }   // Red - White
+    else if (ratio_buf >= 4) {*r = 255;           *g = col_val;       *b = 0;           }   // Yellow - Red
+    else if (ratio_buf >= 3) {*r = col_val;       *g = 255;           *b = 0;           }   // Green - Yellow
+    else if (ratio_buf >= 2) {*r = 0;             *g = 255;           *b = col_val;     }   // Sky - Green
+    else if (ratio_buf >= 1) {*r = 0;             *g = col_val;       *b = 255;         }   // Blue - Sky
+    else if (ratio_buf >= 0) {*r = 0;             *g = 0;             *b = 255-col_val; }   // Black - Blue
+    else                     {*r = 0;             *g = 0;             *b = 0;           }   // Black
+
+    /*
+    // without Black/White
+    int32_t ratio_buf = 4.0f * ratio;
+    uint8_t col_val = 127.5f * (-cosf(4.0f * M_PI * ratio) + 1.0f);
+         if (ratio_buf >= 4){r = 255;     g = 0;       b = 0;       }   // Red
+    else if (ratio_buf >= 3){r = 255;     g = col_val; b = 0;       }   // Yellow - Red
+    else if (ratio_buf >= 2){r = col_val; g = 255;     b = 0;       }   // Green - Yellow
+    else if (ratio_buf >= 1){r = 0;       g = 255;     b = col_val; }   // Sky - Green
+    else if (ratio_buf >= 0){r = 0;       g = col_val; b = 255;     }   // Blue - Sky
+    else                    {r = 0;       g = 0;       b = 255;     }   // Blue
+    */
+
+	return 0;
+}
+
+
+///// Indexed color functions
+/**
+  * @brief  Create an indexed color (palettized) BMP image.
+  * @param  width  width of image [pixel]
+  * @param  height height of image [pixel]
+  * @param  bits   bits per pixel (4: 16 colors, 8: 256 colors)
+  * @retval pointer to the created image. When error, return NULL
+  * @detail Pixels hold palette indices (cleared to 0) and the palette is cleared to black.
+  *         Set the palette with BMP_RGB565_setColorScalePalette() or BMP_RGB565_setPaletteEntry().
+  *         The image is a standard BMP file and is freed with BMP_RGB565_free().
+  */
+uint8_t *BMP_RGB565_createIndexed(uint32_t width, uint32_t height, uint32_t bits)
+{
+    uint32_t data_size = BMP_RGB565_calcIndexedFileSize(width, height, bits);
+    if (data_size == 0)
+        return NULL;
+
+    uint8_t *pbmp = (uint8_t *)bmp_rgb565_malloc(sizeof(uint8_t) * data_size);
+    if (pbmp == NULL)
+        return NULL;
+    memset(pbmp, 0, data_size);
+
+    uint32_t colors = 1u << bits;
+    uint32_t offset = BMP_RGB565_FILE_HEADER_SIZE + BMP_RGB565_INFO_HEADER_SIZE + colors * 4;
+
+    // File header
+    uint8_t *tmp = pbmp;
+    *(tmp  +  0) = 'B';                                        // 'B' : Magic number
+    *(tmp  +  1) = 'M';                                        // 'M' : Magic number
+    BMP_RGB565_write_uint32_t(data_size        , tmp + 0x02);  // File Size
+    BMP_RGB565_write_uint32_t(offset           , tmp + 0x0A);  // Offset
+    tmp += BMP_RGB565_FILE_HEADER_SIZE;    // Next
+
+    // Info header
+    BMP_RGB565_write_uint32_t( BMP_RGB565_INFO_HEADER_SIZE, tmp + 0x00);   // HeaderSize
+    BMP_RGB565_write_uint32_t( width           , tmp + 0x04);  // width
+    BMP_RGB565_write_uint32_t( height          , tmp + 0x08);  // height
+    BMP_RGB565_write_uint16_t( 1               , tmp + 0x0C);  // planes
+    BMP_RGB565_write_uint16_t( bits            , tmp + 0x0E);  // Bit count
+    BMP_RGB565_write_uint32_t( 0               , tmp + 0x10);  // Bit compression (BI_RGB)
+    BMP_RGB565_write_uint32_t( data_size - offset, tmp + 0x14);  // Image size
+    BMP_RGB565_write_uint32_t( colors          , tmp + 0x20);  // Color index
+    return pbmp;
+}
+
+/**
+  * @brief  Calculate file size of an indexed color image.
+  * @param  width  width of image [pixel]
+  * @param  height height of image [pixel]
+  * @param  bits   bits per pixel (4 or 8)
+  * @retval file size (header + palette + pixel data) [byte]. When error, return 0
+  */
+uint32_t BMP_RGB565_calcIndexedFileSize(uint32_t width, uint32_t height, uint32_t bits)
+{
+    if ((bits != 4 && bits != 8) || width == 0 || height == 0
+     || width > BMP_RGB565_MAX_DIMENSION || height > BMP_RGB565_MAX_DIMENSION)
+        return 0;
+
+    uint64_t data_size = BMP_RGB565_FILE_HEADER_SIZE + BMP_RGB565_INFO_HEADER_SIZE + (1u << bits) * 4
+                       + (uint64_t)BMP_RGB565_getIndexedBytesPerRow(width, bits) * height;
+    return (data_size > BMP_RGB565_MAX_FILE_SIZE) ? 0 : (uint32_t)data_size;
+}
+
+/**
+  * @brief  Get bits per pixel of a image.
+  * @param  pbmp pointer to a image
+  * @retval bits per pixel (16: RGB565 image, 4 or 8: indexed color image)
+  */
+uint32_t BMP_RGB565_getBitCount(uint8_t *pbmp)
+{
+    return BMP_RGB565_read_uint16_t(pbmp + BMP_RGB565_FILE_HEADER_SIZE + 0x0E);
+}
+
+/**
+  * @brief  Set a palette entry of an indexed color image.
+  * @param  pbmp  pointer to an indexed color image
+  * @param  index palette index (Range:[0,2^bits-1])
+  * @param  r	Red   value [0, 255]
+  * @param  g	Green value [0, 255]
+  * @param  b	Blue  value [0, 255]
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Every pixel holding the index changes color without touching the pixel data.
+  */
+int BMP_RGB565_setPaletteEntry(uint8_t *pbmp, uint32_t index, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (pbmp == NULL || !BMP_RGB565_isIndexed(pbmp) || index >= (1u << BMP_RGB565_getBitCount(pbmp)))
+        return -1;
+
+    uint8_t *entry = pbmp + BMP_RGB565_FILE_HEADER_SIZE + BMP_RGB565_INFO_HEADER_SIZE + index * 4;
+    entry[0] = b;
+    entry[1] = g;
+    entry[2] = r;
+    entry[3] = 0;
+    return 0;
+}
+
+/**
+  * @brief  Fill the palette of an indexed color image with BMP_RGB565_colorScale().
+  * @param  pbmp  pointer to an indexed color image
+  * @param  steps number of colors of the scale (Range:[2,2^bits])
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Index i is the color of i / (steps - 1) on the scale (0: black, steps - 1: white).
+  *         Entries after the scale are left unchanged, e.g. for overlay colors.
+  */
+int BMP_RGB565_setColorScalePalette(uint8_t *pbmp, uint32_t steps)
+{
+    uint8_t r, g, b;
+
+    if (pbmp == NULL || !BMP_RGB565_isIndexed(pbmp) || steps < 2 || steps > (1u << BMP_RGB565_getBitCount(pbmp)))
+        return -1;
+
+    for (uint32_t i = 0; i < steps; i++)
+    {
+        BMP_RGB565_colorScale((float)i, (float)(steps - 1), 0.0f, &r, &g, &b);
+        BMP_RGB565_setPaletteEntry(pbmp, i, r, g, b);
+    }
+    return 0;
+}
+
+/**
+  * @brief  Get the palette of an indexed color image as RGB565 colors.
+  * @param  pbmp pointer to an indexed color image
+  * @param  lut  pointer to a lookup table of 2^bits entries
+  * @retval number of entries. When error, return 0
+  */
+uint32_t BMP_RGB565_getPalette565(uint8_t *pbmp, uint16_t *lut)
+{
+    if (pbmp == NULL || lut == NULL || !BMP_RGB565_isIndexed(pbmp))
+        return 0;
+
+    uint32_t colors = 1u << BMP_RGB565_getBitCount(pbmp);
+    const uint8_t *entry = pbmp + BMP_RGB565_FILE_HEADER_SIZE + BMP_RGB565_INFO_HEADER_SIZE;
+    for (uint32_t i = 0; i < colors; i++, entry += 4)
+        lut[i] = BMP_RGB565_toRGB565(entry[2], entry[1], entry[0]);
+    return colors;
+}
+
+/**
+  * @brief  Convert a value to a palette index of BMP_RGB565_setColorScalePalette().
+  * @param  val    Value
+  * @param  maxVal Maximum value
+  * @param  minVal Minimum value
+  * @param  steps  number of colors of the scale
+  * @retval palette index (Range:[0,steps-1])
+  */
+uint8_t BMP_RGB565_valueToIndex(float val, float maxVal, float minVal, uint32_t steps)
+{
+    if (maxVal <= minVal || steps < 2)
+        return 0;
+
+    float ratio = (val - minVal) / (maxVal - minVal);
+    if (!(ratio > 0.0f))
+        return 0;
+    if (ratio >= 1.0f)
+        return (uint8_t)(steps - 1);
+    return (uint8_t)(ratio * (float)(steps - 1) + 0.5f);
+}
+
+/**
+  * @brief  Convert a frame of values to the pixels of an indexed color image.
+  * @param  pbmp   pointer to an indexed color image
+  * @param  pSrc   pointer to width * height values (row y = pSrc + y * width)
+  * @param  maxVal Maximum value
+  * @param  minVal Minimum value
+  * @param  steps  number of colors of the scale (Range:[2,2^bits])
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_valuesToIndexed(uint8_t *pbmp, const float *pSrc, float maxVal, float minVal, uint32_t steps)
+{
+    if (pbmp == NULL || pSrc == NULL || !BMP_RGB565_isIndexed(pbmp) || maxVal <= minVal
+     || steps < 2 || steps > (1u << BMP_RGB565_getBitCount(pbmp)))
+        return -1;
+
+    uint32_t width  = BMP_RGB565_getWidth(pbmp);
+    uint32_t height = BMP_RGB565_getHeight(pbmp);
+    uint32_t bits   = BMP_RGB565_getBitCount(pbmp);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        uint8_t *row = BMP_RGB565_getIndexedRowAddr(pbmp, y);
+        const float *src = pSrc + (size_t)y * width;
+        for (uint32_t x = 0; x < width; x++)
+            BMP_RGB565_putIndex(row, x, bits, BMP_RGB565_valueToIndex(src[x], maxVal, minVal, steps));
+    }
+    return 0;
+}
+
+/**
+  * @brief  Expand an indexed color image to a RGB565 image through its palette.
+  * @param  pbmpSrc pointer to an indexed color image
+  * @param  pbmpDst pointer to a RGB565 image of the same size
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_expandIndexed(uint8_t *pbmpSrc, uint8_t *pbmpDst)
+{
+    uint16_t lut[256];
+
+    if (pbmpSrc == NULL || !BMP_RGB565_is565(pbmpDst) || BMP_RGB565_getPalette565(pbmpSrc, lut) == 0)
+        return -1;
+
+    uint32_t width  = BMP_RGB565_getWidth(pbmpSrc);
+    uint32_t height = BMP_RGB565_getHeight(pbmpSrc);
+    if (BMP_RGB565_getWidth(pbmpDst) != width || BMP_RGB565_getHeight(pbmpDst) != height)
+        return -1;
+
+    uint32_t bits = BMP_RGB565_getBitCount(pbmpSrc);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const uint8_t *src = BMP_RGB565_getIndexedRowAddr(pbmpSrc, y);
+        uint16_t *dst = (uint16_t *)BMP_RGB565_getRowAddr(pbmpDst, y);
+        if (bits == 8)
+        {
+            for (uint32_t x = 0; x < width; x++)
+                BMP_RGB565_put565(dst, x, lut[src[x]]);
+        }
+        else
+        {
+            for (uint32_t x = 0; x < width; x++)
+                BMP_RGB565_put565(dst, x, lut[(src[x >> 1] >> ((x & 1) ? 0 : 4)) & 0x0F]);
+        }
+    }
+    return 0;
+}
+
+/**
+  * @brief  Get a pointer to the pixels of a row of an indexed color image.
+  * @param  pbmp pointer to an indexed color image
+  * @param  y	y of a image(Range:[0,height-1]) [pixel]
+  * @retval pointer to the first byte of row y. When error, return NULL
+  * @detail 8bpp: one index per byte. 4bpp: two indices per byte, the left pixel in the upper 4 bits.
+  */
+uint8_t *BMP_RGB565_getIndexedRow(uint8_t *pbmp, uint32_t y)
+{
+    if (pbmp == NULL || !BMP_RGB565_isIndexed(pbmp) || y >= BMP_RGB565_getHeight(pbmp))
+        return NULL;
+
+    return BMP_RGB565_getIndexedRowAddr(pbmp, y);
+}
+
+/**
+  * @brief  Set a palette index on a specified pixel.
+  * @param  pbmp  pointer to an indexed color image
+  * @param  x	x of a image(Range:[0,width-1] ) [pixel]
+  * @param  y	y of a image(Range:[0,height-1]) [pixel]
+  * @param  index palette index
+  * @retval None
+  */
+void BMP_RGB565_setPixelIndex(uint8_t *pbmp, uint32_t x, uint32_t y, uint8_t index)
+{
+    if (pbmp == NULL || !BMP_RGB565_isIndexed(pbmp) || x >= BMP_RGB565_getWidth(pbmp) || y >= BMP_RGB565_getHeight(pbmp))
+        return;
+
+    BMP_RGB565_putIndex(BMP_RGB565_getIndexedRowAddr(pbmp, y), x, BMP_RGB565_getBitCount(pbmp), index);
+}
+
+/**
+  * @brief  Get a palette index on a specified pixel.
+  * @param  pbmp pointer to an indexed color image
+  * @param  x	x of a image(Range:[0,width-1] ) [pixel]
+  * @param  y	y of a image(Range:[0,height-1]) [pixel]
+  * @retval palette index. When out of range, return 0
+  */
+uint8_t BMP_RGB565_getPixelIndex(uint8_t *pbmp, uint32_t x, uint32_t y)
+{
+    if (pbmp == NULL || !BMP_RGB565_isIndexed(pbmp) || x >= BMP_RGB565_getWidth(pbmp) || y >= BMP_RGB565_getHeight(pbmp))
+        return 0;
+
+    const uint8_t *row = BMP_RGB565_getIndexedRowAddr(pbmp, y);
+    if (BMP_RGB565_getBitCount(pbmp) == 8)
+        return row[x];
+    return (row[x >> 1] >> ((x & 1) ? 0 : 4)) & 0x0F;
+}
+
+/**
+  * @brief  Draws a straight line with a specified palette index.
+  * @param  pbmp  pointer to an indexed color image
+  * @param  x0	Start x position of a line(Range:[0,width-1] ) [pixel]
+  * @param  y0  Start y position of a line(Range:[0,height-1]) [pixel]
+  * @param  x1	End   x position of a line(Range:[0,width-1] ) [pixel]
+  * @param  y1  End   y position of a line(Range:[0,height-1]) [pixel]
+  * @param  index palette index
+  * @retval None
+  * @detail Bresenham's line algorithm (see BMP_RGB565_drawLine565())
+  */
+void BMP_RGB565_drawLineIndex(uint8_t *pbmp,
+        int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+        uint8_t index)
+{
+    if (pbmp == NULL || !BMP_RGB565_isIndexed(pbmp))
+        return;
+
+    uint32_t width  = BMP_RGB565_getWidth(pbmp);
+    uint32_t height = BMP_RGB565_getHeight(pbmp);
+    uint32_t bits   = BMP_RGB565_getBitCount(pbmp);
+
+    if(x0 < 0 || (uint32_t)x0 >= width || x1 < 0 || (uint32_t)x1 >= width || y0 < 0 || (uint32_t)y0 >= height || y1 < 0 || (uint32_t)y1 >= height)
+        return;
+
+    int32_t dx = x1 - x0 > 0 ? x1 - x0 : x0 - x1;
+    int32_t sx = x0 < x1 ? 1 : -1;
+    int32_t dy = y1 - y0 > 0 ? y1 - y0 : y0 - y1;
+    int32_t sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx - dy;
+    int32_t e2;
+
+    for (;;)
+    {
+        BMP_RGB565_putIndex(BMP_RGB565_getIndexedRowAddr(pbmp, y0), x0, bits, index);
+
+        if (x0 == x1 && y0 == y1)
+            break;
+
+        e2 = 2*err;
+        if (e2 > -dy) {err -= dy;   x0 += sx;}
+        if (e2 <  dx) {err += dx;   y0 += sy;}
+    }
+}
+
+/**
+  * @brief  Draws a Rectangle with a specified palette index.
+  * @param  pbmp  pointer to an indexed color image
+  * @param  x0	Start x position of a rectangle(Range:[0,width-1] ) [pixel]
+  * @param  y0  Start y position of a rectangle(Range:[0,height-1]) [pixel]
+  * @param  x1	End   x position of a rectangle(Range:[0,width-1] ) [pixel]
+  * @param  y1  End   y position of a rectangle(Range:[0,height-1]) [pixel]
+  * @param  index palette index
+  * @retval None
+  */
+void BMP_RGB565_drawRectIndex(uint8_t *pbmp,
+        uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1,
+        uint8_t index)
+{
+    if (pbmp == NULL || !BMP_RGB565_isIndexed(pbmp))
+        return;
+
+    uint32_t width  = BMP_RGB565_getWidth(pbmp);
+    uint32_t height = BMP_RGB565_getHeight(pbmp);
+    uint32_t bits   = BMP_RGB565_getBitCount(pbmp);
+
+    if (x0 >= width || x1 >= width || y0 >= height || y1 >= height)
+        return;
+
+    uint32_t swap;
+    if (x0 > x1)
+    {
+        swap = x0;
+        x0 = x1;
+        x1 = swap;
+    }
+    if (y0 > y1)
+    {
+        swap = y0;
+        y0 = y1;
+        y1 = swap;
+    }
+
+    for (uint32_t y = y0; y <= y1; y++)
+    {
+        uint8_t *row = BMP_RGB565_getIndexedRowAddr(pbmp, y);
+        if (bits == 8)
+            memset(row + x0, index, x1 - x0 + 1);
+        else
+            for (uint32_t x = x0; x <= x1; x++)
+                BMP_RGB565_putIndex(row, x, bits, index);
+    }
+}
+
+/**
+  * @brief  Fill image with a specified palette index.
+  * @param  pbmp  pointer to an indexed color image
+  * @param  index palette index
+  * @retval None
+  */
+void BMP_RGB565_fillIndex(uint8_t *pbmp, uint8_t index)
+{
+    if (pbmp == NULL)
+        return;
+
+    BMP_RGB565_drawRectIndex(pbmp, 0, 0, BMP_RGB565_getWidth(pbmp)-1, BMP_RGB565_getHeight(pbmp)-1, index);
+}
+
+/**
+  * @brief  Draws text with a specified palette index.
+  * @param  pbmp  pointer to an indexed color image
+  * @param  text  pointer to text to write
+  * @param  font  font
+  * @param  x_start	Start x position of characters (Range:[0,width-1] ) [pixel]
+  * @param  y_start Start y position of characters (Range:[0,height-1]) [pixel]
+  * @param  index palette index
+  * @retval None
+  * @detail The fonts to be used must be enabled in `bmp_rgb565.h`.
+  */
+void BMP_RGB565_drawTextIndex(uint8_t *pbmp, const char *text, BMP_RGB565_font_st font,
+    uint32_t x_start, uint32_t y_start,
+    uint8_t index)
+{
+    BMP_RGB565_textIO_st io;
+
+    if(pbmp == NULL || text == NULL || !BMP_RGB565_isIndexed(pbmp))
+        return;
+
+    io.width  = BMP_RGB565_getWidth(pbmp);
+    io.height = BMP_RGB565_getHeight(pbmp);
+    io.bits   = BMP_RGB565_getBitCount(pbmp);
+    io.value  = index;
+    io.getRow = BMP_RGB565_textIndexedRow;
+    io.put    = BMP_RGB565_textPutIndex;
+    io.dst    = pbmp;
+    BMP_RGB565_textRun(&io, text, font, x_start, y_start);
+}
+
+///// Statistics functions
+/**
+  * @brief  Calculate minimum, maximum and mean of a float frame.
+  * @param  pSrc   pointer to values
+  * @param  n      number of values
+  * @param  stats  pointer to a result
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Non-finite values (NaN, +/-Inf, e.g. dead sensor pixels) are ignored.
+  *         Fails if there is no finite value.
+  *         The loop keeps BMP_RGB565_STATS_LANES independent accumulators so that
+  *         the compiler can map it to SIMD registers.
+  */
+int BMP_RGB565_statsFloat(const float *pSrc, uint32_t n, BMP_RGB565_stats_st *stats)
+{
+    float min = INFINITY, max = -INFINITY;
+    double sum = 0.0;
+    uint64_t count = 0;
+
+    if (pSrc == NULL || stats == NULL)
+        return -1;
+
+    BMP_RGB565_statsFloatRun(pSrc, n, &min, &max, &sum, &count);
+    if (count == 0)
+        return -1;
+
+    stats->min  = min;
+    stats->max  = max;
+    stats->mean = (float)(sum / count);
+    return 0;
+}
+
+/**
+  * @brief  Calculate minimum, maximum and mean of a uint16_t frame.
+  * @param  pSrc   pointer to values
+  * @param  n      number of values
+  * @param  stats  pointer to a result
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_statsUint16(const uint16_t *pSrc, uint32_t n, BMP_RGB565_stats_st *stats)
+{
+    if (pSrc == NULL || stats == NULL || n == 0)
+        return -1;
+
+    uint16_t vmin[BMP_RGB565_STATS_LANES], vmax[BMP_RGB565_STATS_LANES];
+    uint32_t vsum[BMP_RGB565_STATS_LANES];
+    uint64_t sum = 0;
+    uint32_t i = 0;
+
+    for (int k = 0; k < BMP_RGB565_STATS_LANES; k++)
+    {
+        vmin[k] = 0xFFFF;
+        vmax[k] = 0;
+    }
+
+    while (i + BMP_RGB565_STATS_LANES <= n)
+    {
+        // BMP_RGB565_STATS_BLOCK values of 16 bits cannot overflow a 32-bit lane
+        uint32_t block_end = i + BMP_RGB565_STATS_BLOCK;
+        if (block_end > n)
+            block_end = n;
+
+        for (int k = 0; k < BMP_RGB565_STATS_LANES; k++)
+            vsum[k] = 0;
+        for (; i + BMP_RGB565_STATS_LANES <= block_end; i += BMP_RGB565_STATS_LANES)
+        {
+            for (int k = 0; k < BMP_RGB565_STATS_LANES; k++)
+            {
+                uint16_t v = pSrc[i + k];
+                vmin[k] = (v < vmin[k]) ? v : vmin[k];
+                vmax[k] = (v > vmax[k]) ? v : vmax[k];
+                vsum[k] += v;
+            }
+        }
+        for (int k = 0; k < BMP_RGB565_STATS_LANES; k++)
+            sum += vsum[k];
+    }
+
+    uint16_t min = 0xFFFF, max = 0;
+    for (int k = 0; k < BMP_RGB565_STATS_LANES; k++)
+    {
+        min = (vmin[k] < min) ? vmin[k] : min;
+        max = (vmax[k] > max) ? vmax[k] : max;
+    }
+    for (; i < n; i++)
+    {
+        min = (pSrc[i] < min) ? pSrc[i] : min;
+        max = (pSrc[i] > max) ? pSrc[i] : max;
+        sum += pSrc[i];
+    }
+
+    stats->min  = min;
+    stats->max  = max;
+    stats->mean = (float)((double)sum / n);
+    return 0;
+}
+
+/**
+  * @brief  Count float values into fixed-width bins.
+  * @param  pSrc   pointer to values
+  * @param  n      number of values
+  * @param  minVal lower edge of the first bin
+  * @param  maxVal upper edge of the last bin
+  * @param  bins   pointer to bins (Cleared by this function)
+  * @param  nbins  number of bins
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Values outside [minVal, maxVal] are counted in the first/last bin.
+  *         Non-finite values (NaN, +/-Inf) are not counted.
+  */
+int BMP_RGB565_histogramFloat(const float *pSrc, uint32_t n, float minVal, float maxVal, uint32_t *bins, uint32_t nbins)
+{
+    if (pSrc == NULL || bins == NULL || nbins == 0 || !(maxVal > minVal) || !isfinite(maxVal - minVal))
+        return -1;
+
+    memset(bins, 0, nbins * sizeof(uint32_t));
+    BMP_RGB565_histogramFloatRun(pSrc, n, minVal, nbins / (maxVal - minVal), bins, nbins);
+    return 0;
+}
+
+/**
+  * @brief  Count uint16_t values into fixed-width bins.
+  * @param  pSrc   pointer to values
+  * @param  n      number of values
+  * @param  minVal lower edge of the first bin
+  * @param  maxVal upper edge of the last bin
+  * @param  bins   pointer to bins (Cleared by this function)
+  * @param  nbins  number of bins
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Values outside [minVal, maxVal] are counted in the first/last bin.
+  */
+int BMP_RGB565_histogramUint16(const uint16_t *pSrc, uint32_t n, uint16_t minVal, uint16_t maxVal, uint32_t *bins, uint32_t nbins)
+{
+    if (pSrc == NULL || bins == NULL || nbins == 0 || maxVal <= minVal)
+        return -1;
+
+    // Fixed point (16.16) bin scale
+    uint32_t range = (uint32_t)maxVal - minVal;
+    uint64_t scale = ((uint64_t)nbins << 16) / range;
+    memset(bins, 0, nbins * sizeof(uint32_t));
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t v = (pSrc[i] < minVal) ? 0 : (uint32_t)pSrc[i] - minVal;
+        uint64_t bin = ((uint64_t)v * scale) >> 16;
+        bins[(bin >= nbins) ? nbins - 1 : bin]++;
+    }
+    return 0;
+}
+
+/**
+  * @brief  Approximate a percentile from a histogram.
+  * @param  bins    pointer to bins
+  * @param  nbins   number of bins
+  * @param  minVal  lower edge of the first bin
+  * @param  maxVal  upper edge of the last bin
+  * @param  percent percentile [0, 100]
+  * @retval value at the percentile (linear interpolation inside a bin)
+  */
+float BMP_RGB565_histogramPercentile(const uint32_t *bins, uint32_t nbins, float minVal, float maxVal, float percent)
+{
+    uint64_t total = 0;
+
+    if (bins == NULL || nbins == 0)
+        return minVal;
+
+    for (uint32_t i = 0; i < nbins; i++)
+        total += bins[i];
+    if (total == 0)
+        return minVal;
+
+    float target = RANGE(percent, 0.0f, 100.0f) / 100.0f * total;
+    float bin_width = (maxVal - minVal) / nbins;
+    uint64_t count = 0;
+
+    for (uint32_t i = 0; i < nbins; i++)
+    {
+        if (bins[i] > 0 && count + bins[i] >= target)
+            return minVal + bin_width * (i + (target - count) / bins[i]);
+        count += bins[i];
+    }
+    return maxVal;
+}
+
+/**
+  * @brief  Update a display range with temporal smoothing.
+  * @param  range  pointer to a range (Clear `valid` to restart smoothing)
+  * @param  minVal minimum value of the current frame
+  * @param  maxVal maximum value of the current frame
+  * @param  alpha  smoothing factor (0, 1]. 1: no smoothing
+  * @retval None
+  * @detail range->maxVal and range->minVal can be passed to BMP_RGB565_colorScale().
+  *         Non-finite values are ignored so that a bad frame does not poison the range.
+  */
+void BMP_RGB565_rangeUpdate(BMP_RGB565_range_st *range, float minVal, float maxVal, float alpha)
+{
+    if (range == NULL || !isfinite(minVal) || !isfinite(maxVal))
+        return;
+
+    if (!range->valid)
+    {
+        range->minVal = minVal;
+        range->maxVal = maxVal;
+        range->valid  = 1;
+        return;
+    }
+    alpha = RANGE(alpha, 0.0f, 1.0f);
+    range->minVal += alpha * (minVal - range->minVal);
+    range->maxVal += alpha * (maxVal - range->maxVal);
+}
+
+/**
+  * @brief  Auto-range a float frame for BMP_RGB565_colorScale().
+  * @param  pSrc        pointer to values
+  * @param  n           number of values
+  * @param  lowPercent  lower percentile [0, 100] (e.g. 1)
+  * @param  highPercent upper percentile [0, 100] (e.g. 99)
+  * @param  alpha       smoothing factor (0, 1]. 1: no smoothing
+  * @param  range       pointer to a range updated by this function
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Percentiles are taken from a BMP_RGB565_AUTORANGE_BINS bin histogram
+  *         over [min, max] of the frame, which rejects isolated hot pixels.
+  *         Non-finite values are ignored. Fails if there is no finite value.
+  */
+int BMP_RGB565_autoRangeFloat(const float *pSrc, uint32_t n, float lowPercent, float highPercent, float alpha, BMP_RGB565_range_st *range)
+{
+    BMP_RGB565_stats_st stats;
+    uint32_t bins[BMP_RGB565_AUTORANGE_BINS];
+
+    if (range == NULL || BMP_RGB565_statsFloat(pSrc, n, &stats) != 0)
+        return -1;
+
+    float low = stats.min, high = stats.max;
+    if (BMP_RGB565_histogramFloat(pSrc, n, stats.min, stats.max, bins, BMP_RGB565_AUTORANGE_BINS) == 0)
+    {
+        low  = BMP_RGB565_histogramPercentile(bins, BMP_RGB565_AUTORANGE_BINS, stats.min, stats.max, lowPercent);
+        high = BMP_RGB565_histogramPercentile(bins, BMP_RGB565_AUTORANGE_BINS, stats.min, stats.max, highPercent);
+    }
+    BMP_RGB565_rangeUpdate(range, low, high, alpha);
+    return 0;
+}
+
+/**
+  * @brief  Auto-range a uint16_t frame for BMP_RGB565_colorScale().
+  * @param  pSrc        pointer to values
+  * @param  n           number of values
+  * @param  lowPercent  lower percentile [0, 100] (e.g. 1)
+  * @param  highPercent upper percentile [0, 100] (e.g. 99)
+  * @param  alpha       smoothing factor (0, 1]. 1: no smoothing
+  * @param  range       pointer to a range updated by this function
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_autoRangeUint16(const uint16_t *pSrc, uint32_t n, float lowPercent, float highPercent, float alpha, BMP_RGB565_range_st *range)
+{
+    BMP_RGB565_stats_st stats;
+    uint32_t bins[BMP_RGB565_AUTORANGE_BINS];
+
+    if (range == NULL || BMP_RGB565_statsUint16(pSrc, n, &stats) != 0)
+        return -1;
+
+    float low = stats.min, high = stats.max;
+    if (BMP_RGB565_histogramUint16(pSrc, n, (uint16_t)stats.min, (uint16_t)stats.max, bins, BMP_RGB565_AUTORANGE_BINS) == 0)
+    {
+        low  = BMP_RGB565_histogramPercentile(bins, BMP_RGB565_AUTORANGE_BINS, stats.min, stats.max, lowPercent);
+        high = BMP_RGB565_histogramPercentile(bins, BMP_RGB565_AUTORANGE_BINS, stats.min, stats.max, highPercent);
+    }
+    BMP_RGB565_rangeUpdate(range, low, high, alpha);
+    return 0;
+}
+
+
+///// Filter functions
+/**
+  * @brief  Filter an image.
+  * @param  pbmpSrc pointer to a source image
+  * @param  pbmpDst pointer to a destination image of the same size (May be pbmpSrc)
+  * @param  type    filter type
+  * @param  param   BMP_RGB565_FILTER_BOX: radius [pixel], BMP_RGB565_FILTER_GAUSSIAN: sigma [pixel],
+  *                 otherwise: ignored
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Only a few rows are buffered, so the filter can run in place.
+  */
+int BMP_RGB565_filter(uint8_t *pbmpSrc, uint8_t *pbmpDst, BMP_RGB565_filter_t type, float param)
+{
+    if (pbmpSrc == NULL)
+        return -1;
+
+    return BMP_RGB565_filterBand(pbmpSrc, pbmpDst, type, param, 0, BMP_RGB565_getHeight(pbmpSrc));
+}
+
+/**
+  * @brief  Filter a band of rows of an image.
+  * @param  pbmpSrc pointer to a source image
+  * @param  pbmpDst pointer to a destination image of the same size (Must not be pbmpSrc)
+  * @param  type    filter type
+  * @param  param   see BMP_RGB565_filter()
+  * @param  y_begin first row of the band
+  * @param  y_end   row after the last row of the band
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Bands only read pbmpSrc and write their own rows of pbmpDst,
+  *         so an image can be split into bands processed in parallel.
+  */
+int BMP_RGB565_filterBand(uint8_t *pbmpSrc, uint8_t *pbmpDst, BMP_RGB565_filter_t type, float param,
+        uint32_t y_begin, uint32_t y_end)
+{
+    BMP_RGB565_view_st src, dst;
+
+    if (pbmpSrc == NULL || pbmpDst == NULL)
+        return -1;
+    if (BMP_RGB565_viewInit(&src, pbmpSrc, 0, 0, BMP_RGB565_getWidth(pbmpSrc), BMP_RGB565_getHeight(pbmpSrc)) != 0
+     || BMP_RGB565_viewInit(&dst, pbmpDst, 0, 0, BMP_RGB565_getWidth(pbmpDst), BMP_RGB565_getHeight(pbmpDst)) != 0)
+        return -1;
+
+    return BMP_RGB565_viewFilterBand(&src, &dst, type, param, y_begin, y_end);
+}
+
+/**
+  * @brief  Filter a float frame (e.g. a raw sensor frame).
+  * @param  pSrc   pointer to source values (width x height, row-major)
+  * @param  pDst   pointer to destination values (May be pSrc)
+  * @param  width  width  of a frame
+  * @param  height height of a frame
+  * @param  type   filter type
+  * @param  param  see BMP_RGB565_filter()
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_filterFloat(const float *pSrc, float *pDst, uint32_t width, uint32_t height,
+        BMP_RGB565_filter_t type, float param)
+{
+    return BMP_RGB565_filterFloatBand(pSrc, pDst, width, height, type, param, 0, height);
+}
+
+/**
+  * @brief  Filter a band of rows of a float frame.
+  * @param  pSrc    pointer to source values (width x height, row-major)
+  * @param  pDst    pointer to destination values (Must not be pSrc)
+  * @param  width   width  of a frame
+  * @param  height  height of a frame
+  * @param  type    filter type
+  * @param  param   see BMP_RGB565_filter()
+  * @param  y_begin first row of the band
+  * @param  y_end   row after the last row of the band
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_filterFloatBand(const float *pSrc, float *pDst, uint32_t width, uint32_t height,
+        BMP_RGB565_filter_t type, float param, uint32_t y_begin, uint32_t y_end)
+{
+    if (pSrc == NULL || pDst == NULL)
+        return -1;
+
+    BMP_RGB565_filterIO_st io;
+    io.width    = width;
+    io.height   = height;
+    io.channels = 1;
+    io.load     = BMP_RGB565_filterLoadFloat;
+    io.store    = BMP_RGB565_filterStoreFloat;
+    io.src      = pSrc;
+    io.dst      = pDst;
+
+    return BMP_RGB565_filterRun(&io, type, param, y_begin, y_end);
+}
+
+
+///// View functions
+/**
+  * @brief  Initialize a view of a region of an image.
+  * @param  view   pointer to a view
+  * @param  pbmp   pointer to a image
+  * @param  x      x of the upper left pixel of the region [pixel]
+  * @param  y      y of the upper left pixel of the region [pixel]
+  * @param  width  width of the region [pixel]
+  * @param  height height of the region [pixel]
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail The view shares the pixels of the image (nothing is copied) and is valid
+  *         while the image is. The region is clipped to the image. Fails if it is empty.
+  */
+int BMP_RGB565_viewInit(BMP_RGB565_view_st *view, uint8_t *pbmp, int32_t x, int32_t y, uint32_t width, uint32_t height)
+{
+    if (view == NULL || !BMP_RGB565_is565(pbmp))
+        return -1;
+
+    BMP_RGB565_view_st full;
+    uint32_t bytes_per_row = BMP_RGB565_getBytesPerRow(BMP_RGB565_getWidth(pbmp));
+    int32_t  height_signed = (int32_t)BMP_RGB565_read_uint32_t(pbmp + BMP_RGB565_FILE_HEADER_SIZE + 0x08);
+    full.width  = BMP_RGB565_getWidth(pbmp);
+    full.height = BMP_RGB565_getHeight(pbmp);
+    full.x      = 0;
+    full.y      = 0;
+    full.stride = (height_signed < 0) ? (ptrdiff_t)bytes_per_row : -(ptrdiff_t)bytes_per_row;
+    full.data   = (full.height > 0) ? BMP_RGB565_getRowAddr(pbmp, 0) : NULL;
+
+    return BMP_RGB565_viewSub(view, &full, x, y, width, height);
+}
+
+/**
+  * @brief  Initialize a view of a region of another view.
+  * @param  view   pointer to a view to initialize
+  * @param  parent pointer to a parent view
+  * @param  x      x of the upper left pixel of the region in the parent [pixel]
+  * @param  y      y of the upper left pixel of the region in the parent [pixel]
+  * @param  width  width of the region [pixel]
+  * @param  height height of the region [pixel]
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail The region is clipped to the parent. Fails if it is empty.
+  */
+int BMP_RGB565_viewSub(BMP_RGB565_view_st *view, const BMP_RGB565_view_st *parent, int32_t x, int32_t y, uint32_t width, uint32_t height)
+{
+    if (view == NULL || parent == NULL || parent->data == NULL)
+        return -1;
+
+    int64_t x0 = x, y0 = y;
+    int64_t x1 = x0 + width, y1 = y0 + height;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > parent->width)  x1 = parent->width;
+    if (y1 > parent->height) y1 = parent->height;
+    if (x0 >= x1 || y0 >= y1)
+        return -1;
+
+    view->data   = parent->data + parent->stride * (ptrdiff_t)y0 + (ptrdiff_t)x0 * 2;
+    view->stride = parent->stride;
+    view->x      = parent->x + (uint32_t)x0;
+    view->y      = parent->y + (uint32_t)y0;
+    view->width  = (uint32_t)(x1 - x0);
+    view->height = (uint32_t)(y1 - y0);
+    return 0;
+}
+
+/**
+  * @brief  Get a pointer to the pixels of a row of a view.
+  * @param  view pointer to a view
+  * @param  y	y of the view (Range:[0,height-1]) [pixel]
+  * @retval pointer to the first pixel of row y. When error, return NULL
+  */
+uint16_t *BMP_RGB565_viewGetRow(const BMP_RGB565_view_st *view, uint32_t y)
+{
+    if (view == NULL || y >= view->height)
+        return NULL;
+
+    return (uint16_t *)(view->data + view->stride * (ptrdiff_t)y);
+}
+
+/**
+  * @brief  Draw a RGB565 color on a specified pixel of a view.
+  * @param  view pointer to a view
+  * @param  x	x of the view (Range:[0,width-1] ) [pixel]
+  * @param  y	y of the view (Range:[0,height-1]) [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  */
+void BMP_RGB565_viewSetPixel565(const BMP_RGB565_view_st *view, int32_t x, int32_t y, uint16_t col)
+{
+    if (view == NULL || x < 0 || (uint32_t)x >= view->width || y < 0 || (uint32_t)y >= view->height)
+        return;
+
+    BMP_RGB565_put565(BMP_RGB565_viewGetRow(view, y), x, col);
+}
+
+/**
+  * @brief  Get a RGB565 color on a specified pixel of a view.
+  * @param  view pointer to a view
+  * @param  x	x of the view (Range:[0,width-1] ) [pixel]
+  * @param  y	y of the view (Range:[0,height-1]) [pixel]
+  * @retval RGB565 color. When out of range, return 0
+  */
+uint16_t BMP_RGB565_viewGetPixel565(const BMP_RGB565_view_st *view, int32_t x, int32_t y)
+{
+    if (view == NULL || x < 0 || (uint32_t)x >= view->width || y < 0 || (uint32_t)y >= view->height)
+        return 0;
+
+    return BMP_RGB565_get565(BMP_RGB565_viewGetRow(view, y), x);
+}
+
+/**
+  * @brief  Draws a straight line in a specified RGB565 color on a view.
+  * @param  view pointer to a view
+  * @param  x0	Start x position of a line [pixel]
+  * @param  y0  Start y position of a line [pixel]
+  * @param  x1	End   x position of a line [pixel]
+  * @param  y1  End   y position of a line [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  * @detail Bresenham's line algorithm. Pixels outside the view are not drawn.
+  */
+void BMP_RGB565_viewDrawLine565(const BMP_RGB565_view_st *view,
+        int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+        uint16_t col)
+{
+    if (view == NULL)
+        return;
+
+    int32_t dx = x1 - x0 > 0 ? x1 - x0 : x0 - x1;
+    int32_t sx = x0 < x1 ? 1 : -1;
+    int32_t dy = y1 - y0 > 0 ? y1 - y0 : y0 - y1;
+    int32_t sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx - dy;
+    int32_t e2;
+
+    for (;;)
+    {
+        if (x0 >= 0 && (uint32_t)x0 < view->width && y0 >= 0 && (uint32_t)y0 < view->height)
+            BMP_RGB565_put565(BMP_RGB565_viewGetRow(view, y0), x0, col);
+
+        if (x0 == x1 && y0 == y1)
+            break;
+
+        e2 = 2*err;
+        if (e2 > -dy) {err -= dy;   x0 += sx;}
+        if (e2 <  dx) {err += dx;   y0 += sy;}
+    }
+}
+
+/**
+  * @brief  Draws a filled rectangle in a specified RGB565 color on a view.
+  * @param  view pointer to a view
+  * @param  x0	Start x position of a rectangle [pixel]
+  * @param  y0  Start y position of a rectangle [pixel]
+  * @param  x1	End   x position of a rectangle [pixel]
+  * @param  y1  End   y position of a rectangle [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  * @detail The rectangle is clipped to the view.
+  */
+void BMP_RGB565_viewDrawRect565(const BMP_RGB565_view_st *view,
+        int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+        uint16_t col)
+{
+    if (view == NULL)
+        return;
+
+    int32_t swap;
+    if (x0 > x1)
+    {
+        swap = x0;
+        x0 = x1;
+        x1 = swap;
+    }
+    if (y0 > y1)
+    {
+        swap = y0;
+        y0 = y1;
+        y1 = swap;
+    }
+    if (x1 < 0 || y1 < 0 || (x0 >= 0 && (uint32_t)x0 >= view->width) || (y0 >= 0 && (uint32_t)y0 >= view->height))
+        return;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if ((uint32_t)x1 >= view->width)  x1 = (int32_t)(view->width - 1);
+    if ((uint32_t)y1 >= view->height) y1 = (int32_t)(view->height - 1);
+
+    for (int32_t y = y0; y <= y1; y++)
+    {
+        uint16_t *row = BMP_RGB565_viewGetRow(view, y);
+        for (int32_t x = x0; x <= x1; x++)
+            BMP_RGB565_put565(row, x, col);
+    }
+}
+
+/**
+  * @brief  Fill a view in a specified RGB565 color.
+  * @param  view pointer to a view
+  * @param  col	RGB565 color
+  * @retval None
+  */
+void BMP_RGB565_viewFill565(const BMP_RGB565_view_st *view, uint16_t col)
+{
+    if (view == NULL)
+        return;
+
+    BMP_RGB565_viewDrawRect565(view, 0, 0, (int32_t)view->width - 1, (int32_t)view->height - 1, col);
+}
+
+/**
+  * @brief  Draws text in a specified RGB565 color on a view.
+  * @param  view pointer to a view
+  * @param  text pointer to text to write
+  * @param  font font
+  * @param  x_start	Start x position of characters [pixel]
+  * @param  y_start Start y position of characters [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  * @detail Characters are clipped to the view.
+  */
+void BMP_RGB565_viewDrawText565(const BMP_RGB565_view_st *view, const char *text, BMP_RGB565_font_st font,
+    int32_t x_start, int32_t y_start,
+    uint16_t col)
+{
+    BMP_RGB565_textIO_st io;
+
+    if(view == NULL || text == NULL)
+        return;
+
+    io.width  = view->width;
+    io.height = view->height;
+    io.bits   = 16;
+    io.value  = col;
+    io.getRow = BMP_RGB565_textViewRow;
+    io.put    = BMP_RGB565_textPut565;
+    io.dst    = view;
+    BMP_RGB565_textRun(&io, text, font, x_start, y_start);
+}
+
+/**
+  * @brief  Copy the pixels of a view to a position of another view.
+  * @param  src pointer to a source view
+  * @param  dst pointer to a destination view
+  * @param  x   x of the destination of the upper left pixel of src [pixel]
+  * @param  y   y of the destination of the upper left pixel of src [pixel]
+  * @retval None
+  * @detail The copy is clipped to dst. Views may overlap (e.g. regions of the same image).
+  */
+void BMP_RGB565_viewBlit(const BMP_RGB565_view_st *src, const BMP_RGB565_view_st *dst, int32_t x, int32_t y)
+{
+    if (src == NULL || dst == NULL)
+        return;
+
+    // Clip [x, x + width) x [y, y + height) to dst
+    int64_t sx = 0, sy = 0;
+    int64_t dx = x, dy = y;
+    int64_t w = src->width, h = src->height;
+    if (dx < 0) { sx -= dx; w += dx; dx = 0; }
+    if (dy < 0) { sy -= dy; h += dy; dy = 0; }
+    if (dx + w > dst->width)  w = dst->width  - dx;
+    if (dy + h > dst->height) h = dst->height - dy;
+    if (w <= 0 || h <= 0)
+        return;
+
+    const uint8_t *pSrc = src->data + src->stride * (ptrdiff_t)sy + (ptrdiff_t)sx * 2;
+    uint8_t *pDst = dst->data + dst->stride * (ptrdiff_t)dy + (ptrdiff_t)dx * 2;
+    size_t bytes = (size_t)w * 2;
+
+    // Copy rows in the order that does not overwrite source rows not yet copied
+    if (pDst > pSrc && src->stride == dst->stride && src->stride > 0)
+        for (int64_t i = h - 1; i >= 0; i--)
+            memmove(pDst + dst->stride * (ptrdiff_t)i, pSrc + src->stride * (ptrdiff_t)i, bytes);
+    else if (pDst < pSrc && src->stride == dst->stride && src->stride < 0)
+        for (int64_t i = h - 1; i >= 0; i--)
+            memmove(pDst + dst->stride * (ptrdiff_t)i, pSrc + src->stride * (ptrdiff_t)i, bytes);
+    else
+        for (int64_t i = 0; i < h; i++)
+            memmove(pDst + dst->stride * (ptrdiff_t)i, pSrc + src->stride * (ptrdiff_t)i, bytes);
+}
+
+/**
+  * @brief  Bicubic interpolation of a view to fill another view.
+  * @param  src pointer to a source view
+  * @param  dst pointer to a destination view (Must not overlap src)
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail See BMP_RGB565_resize_bicubic().
+  */
+int BMP_RGB565_viewResizeBicubic(const BMP_RGB565_view_st *src, const BMP_RGB565_view_st *dst)
+{
+	int src_x_size, src_y_size, dst_x_size, dst_y_size;
+	float C[4][3];
+	float d0[3], d2[3], d3[3], a0[3], a1, a2, a3;
+	int x, y;
+	float dx, dy;
+	float tx, ty;
+    uint8_t rgb1[3], rgb2[3], rgb_out[3];
+
+	if(src == NULL || dst == NULL)
+		return -1;
+
+    for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 3; j++)
+        C[i][j] = 0.0f;
+
+	src_x_size = src->width;
+	src_y_size = src->height;
+	dst_x_size = dst->width;
+	dst_y_size = dst->height;
+
+	tx = (float)src_x_size / dst_x_size;
+	ty = (float)src_y_size / dst_y_size;
+
+	for (int dstCol = 0; dstCol < dst_y_size; dstCol++)
+	{
+		for (int dstRow = 0; dstRow < dst_x_size; dstRow++)
+		{
+			x = (int) (tx * dstRow);
+			y = (int) (ty * dstCol);
+
+			dx = tx * dstRow - x;
+			dy = ty * dstCol - y;
+
+			for (int i = 0; i < 3; i++)
+			{
+				for (int j = 0; j <= 3; j++)
+				{
+					BMP_RGB565_viewGetRGB(src, RANGE((x - 1) + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), rgb1);
+					BMP_RGB565_viewGetRGB(src, RANGE((x)     + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), rgb2);
+					for(int rgb_i = 0; rgb_i < 3; rgb_i++)
+						d0[rgb_i] = rgb1[rgb_i] - rgb2[rgb_i];
+
+					BMP_RGB565_viewGetRGB(src, RANGE((x + 1) + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), rgb1);
+					BMP_RGB565_viewGetRGB(src, RANGE((x)     + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), rgb2);
 					for(int rgb_i = 0; rgb_i < 3; rgb_i++)
 						d2[rgb_i] = rgb1[rgb_i] - rgb2[rgb_i];
 
-					BMP_RGB565_getPixelRGB(pbmpSrc, RANGE((x + 2) + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), &rgb1[0], &rgb1[1], &rgb1[2]);
-					BMP_RGB565_getPixelRGB(pbmpSrc, RANGE((x)     + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), &rgb2[0], &rgb2[1], &rgb2[2]);
+					BMP_RGB565_viewGetRGB(src, RANGE((x + 2) + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), rgb1);
+					BMP_RGB565_viewGetRGB(src, RANGE((x)     + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), rgb2);
 					for(int rgb_i = 0; rgb_i < 3; rgb_i++)
 						d3[rgb_i] = rgb1[rgb_i] - rgb2[rgb_i];
 
-					BMP_RGB565_getPixelRGB(pbmpSrc, RANGE((x)     + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), &rgb1[0], &rgb1[1], &rgb1[2]);
-					for(int rgb_i = 0; rgb_i < 3; rgb_i++)
-						a0[rgb_i] = rgb1[rgb_i];
+					BMP_RGB565_viewGetRGB(src, RANGE((x)     + i, 0, src_x_size-1), RANGE(y - 1 + j, 0, src_y_size-1), rgb1);
+					for(int rgb_i = 0; rgb_i < 3; rgb_i++)
+						a0[rgb_i] = rgb1[rgb_i];
+
+					for(int rgb_i = 0; rgb_i < 3; rgb_i++)
+					{
+						a1 = -1.0f / 3 * d0[rgb_i] +            d2[rgb_i] - 1.0f / 6 * d3[rgb_i];
+						a2 =  1.0f / 2 * d0[rgb_i] + 1.0f / 2 * d2[rgb_i];
+						a3 = -1.0f / 6 * d0[rgb_i] - 1.0f / 2 * d2[rgb_i] + 1.0f / 6 * d3[rgb_i];
+						C[j][rgb_i] = a0[rgb_i] + a1 * dx + a2 * dx * dx + a3 * dx * dx * dx;
+
+						float d0_2, d2_2, d3_2, a0_2;
+						d0_2 = C[0][rgb_i] - C[1][rgb_i];
+						d2_2 = C[2][rgb_i] - C[1][rgb_i];
+						d3_2 = C[3][rgb_i] - C[1][rgb_i];
+						a0_2 = C[1][rgb_i];
+						a1 = -1.0f / 3 * d0_2 +            d2_2 - 1.0f / 6 * d3_2;
+						a2 =  1.0f / 2 * d0_2 + 1.0f / 2 * d2_2;
+						a3 = -1.0f / 6 * d0_2 - 1.0f / 2 * d2_2 + 1.0f / 6 * d3_2;
+
+						rgb_out[rgb_i] = RANGE( (int)(a0_2 + a1 * dy + a2 * dy * dy + a3 * dy * dy * dy + 0.5f), 0, 255);
+					}
+					BMP_RGB565_viewSetPixel565(dst, dstRow + i, dstCol, convertRGBtoRGB565(rgb_out[0], rgb_out[1], rgb_out[2]));
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+/**
+  * @brief  Filter a view.
+  * @param  src   pointer to a source view
+  * @param  dst   pointer to a destination view of the same size (May be src)
+  * @param  type  filter type
+  * @param  param see BMP_RGB565_filter()
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Pixels outside src are not read; its edges are extended as for a whole image.
+  */
+int BMP_RGB565_viewFilter(const BMP_RGB565_view_st *src, const BMP_RGB565_view_st *dst, BMP_RGB565_filter_t type, float param)
+{
+    if (src == NULL)
+        return -1;
+
+    return BMP_RGB565_viewFilterBand(src, dst, type, param, 0, src->height);
+}
+
+/**
+  * @brief  Filter a band of rows of a view.
+  * @param  src     pointer to a source view
+  * @param  dst     pointer to a destination view of the same size (Must not overlap src)
+  * @param  type    filter type
+  * @param  param   see BMP_RGB565_filter()
+  * @param  y_begin first row of the band
+  * @param  y_end   row after the last row of the band
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_viewFilterBand(const BMP_RGB565_view_st *src, const BMP_RGB565_view_st *dst, BMP_RGB565_filter_t type, float param,
+        uint32_t y_begin, uint32_t y_end)
+{
+    if (src == NULL || dst == NULL || src->width != dst->width || src->height != dst->height)
+        return -1;
+
+    BMP_RGB565_filterIO_st io;
+    io.width    = src->width;
+    io.height   = src->height;
+    io.channels = 3;
+    io.load     = BMP_RGB565_filterLoadView;
+    io.store    = BMP_RGB565_filterStoreView;
+    io.src      = src;
+    io.dst      = (void *)dst;
+
+    return BMP_RGB565_filterRun(&io, type, param, y_begin, y_end);
+}
+
+/**
+  * @brief  Copy the region of a view to a new image.
+  * @param  view pointer to a view
+  * @retval pointer to the created image. When error, return NULL
+  * @detail Only the rows of the region are read.
+  */
+uint8_t *BMP_RGB565_viewToImage(const BMP_RGB565_view_st *view)
+{
+    if (view == NULL || view->data == NULL)
+        return NULL;
+
+    uint8_t *pbmpDst = BMP_RGB565_create(view->width, view->height);
+    if (pbmpDst == NULL)
+        return NULL;
+
+    for (uint32_t y = 0; y < view->height; y++)
+        memcpy(BMP_RGB565_getRowAddr(pbmpDst, y), BMP_RGB565_viewGetRow(view, y), (size_t)view->width * 2);
+    return pbmpDst;
+}
+
+/**
+  * @brief  Calculate minimum, maximum and mean of a region of a float frame.
+  * @param  pSrc   pointer to the upper left value of the region
+  * @param  stride number of values from a row to the next row of the frame
+  * @param  width  width of the region
+  * @param  height height of the region
+  * @param  stats  pointer to a result
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail See BMP_RGB565_statsFloat().
+  */
+int BMP_RGB565_statsFloatROI(const float *pSrc, uint32_t stride, uint32_t width, uint32_t height, BMP_RGB565_stats_st *stats)
+{
+    float min = INFINITY, max = -INFINITY;
+    double sum = 0.0;
+    uint64_t count = 0;
 
-					for(int rgb_i = 0; rgb_i < 3; rgb_i++)
-					{
-						a1 = -1.0f / 3 * d0[rgb_i] +            d2[rgb_i] - 1.0f / 6 * d3[rgb_i];
-						a2 =  1.0f / 2 * d0[rgb_i] + 1.0f / 2 * d2[rgb_i];
-						a3 = -1.0f / 6 * d0[rgb_i] - 1.0f / 2 * d2[rgb_i] + 1.0f / 6 * d3[rgb_i];
-						C[j][rgb_i] = a0[rgb_i] + a1 * dx + a2 * dx * dx + a3 * dx * dx * dx;
+    if (pSrc == NULL || stats == NULL || width == 0 || height == 0 || stride < width)
+        return -1;
 
-						float d0_2, d2_2, d3_2, a0_2;
-						d0_2 = C[0][rgb_i] - C[1][rgb_i];
-						d2_2 = C[2][rgb_i] - C[1][rgb_i];
-						d3_2 = C[3][rgb_i] - C[1][rgb_i];
-						a0_2 = C[1][rgb_i];
-						a1 = -1.0f / 3 * d0_2 +            d2_2 - 1.0f / 6 * d3_2;
-						a2 =  1.0f / 2 * d0_2 + 1.0f / 2 * d2_2;
-						a3 = -1.0f / 6 * d0_2 - 1.0f / 2 * d2_2 + 1.0f / 6 * d3_2;
+    for (uint32_t y = 0; y < height; y++)
+        BMP_RGB565_statsFloatRun(pSrc + (size_t)stride * y, width, &min, &max, &sum, &count);
+    if (count == 0)
+        return -1;
 
-						rgb_out[rgb_i] = RANGE( (int)(a0_2 + a1 * dy + a2 * dy * dy + a3 * dy * dy * dy + 0.5f), 0, 255);
-					}
-					BMP_RGB565_setPixelRGB(pbmpDst, dstRow + i, dstCol,  rgb_out[0], rgb_out[1], rgb_out[2]);
-				}
-			}
-		}
-	}
-	return pbmpDst;
+    stats->min  = min;
+    stats->max  = max;
+    stats->mean = (float)(sum / count);
+    return 0;
 }
 
-
-///// Support function
 /**
-  * @brief  Color scale function for thermography.
-  * @param  val    Value
-  * @param  maxVal Maximum value
-  * @param  minVal Minimum value
-  * @param  r	   Pointer to a red   value [0, 255]
-  * @param  g	   Pointer to a green value [0, 255]
-  * @param  b	   Pointer to a blue  value [0, 255]
+  * @brief  Calculate minimum, maximum and mean of a region of a uint16_t frame.
+  * @param  pSrc   pointer to the upper left value of the region
+  * @param  stride number of values from a row to the next row of the frame
+  * @param  width  width of the region
+  * @param  height height of the region
+  * @param  stats  pointer to a result
   * @retval status (0: Success, otherwise: Failure)
   */
-int BMP_RGB565_colorScale(float val, float maxVal, float minVal, uint8_t *r, uint8_t *g, uint8_t *b)
+int BMP_RGB565_statsUint16ROI(const uint16_t *pSrc, uint32_t stride, uint32_t width, uint32_t height, BMP_RGB565_stats_st *stats)
 {
-    float ratio;	// 0 ~ 1
-    if (maxVal > minVal)
-    	ratio = (val - minVal) / (maxVal - minVal);
-    else {
-        //printf("Error: maxVal <= minVal\n");
+    BMP_RGB565_stats_st row;
+    double sum = 0.0;
+
+    if (pSrc == NULL || stats == NULL || width == 0 || height == 0 || stride < width)
         return -1;
+
+    for (uint32_t y = 0; y < height; y++)
+    {
+        if (BMP_RGB565_statsUint16(pSrc + (size_t)stride * y, width, &row) != 0)
+            return -1;
+        stats->min = (y == 0 || row.min < stats->min) ? row.min : stats->min;
+        stats->max = (y == 0 || row.max > stats->max) ? row.max : stats->max;
+        sum += (double)row.mean * width;
     }
+    stats->mean = (float)(sum / ((double)width * height));
+    return 0;
+}
 
-    // with Black/White
-    int32_t ratio_buf = 6.0f * ratio;
-    uint8_t col_val = 127.5f * (cosf(6.0f * M_PI * ratio) + 1.0f);	// 127.5 means 255/2
-         if (ratio_buf >= 6) {*r = 255;           *g = 255;           *b = 255;         }   // White
-    else if (ratio_buf >= 5) {*r = 255;           *g = col_val;       *b = col_val;     }   // Red - White
-    else if (ratio_buf >= 4) {*r = 255;           *g = col_val;       *b = 0;           }   // Yellow - Red
-    else if (ratio_buf >= 3) {*r = col_val;       *g = 255;           *b = 0;           }   // Green - Yellow
-    else if (ratio_buf >= 2) {*r = 0;             *g = 255;           *b = col_val;     }   // Sky - Green
-    else if (ratio_buf >= 1) {*r = 0;             *g = col_val;       *b = 255;         }   // Blue - Sky
-    else if (ratio_buf >= 0) {*r = 0;             *g = 0;             *b = 255-col_val; }   // Black - Blue
-    else                     {*r = 0;             *g = 0;             *b = 0;           }   // Black
+/**
+  * @brief  Count float values of a region of a frame into fixed-width bins.
+  * @param  pSrc   pointer to the upper left value of the region
+  * @param  stride number of values from a row to the next row of the frame
+  * @param  width  width of the region
+  * @param  height height of the region
+  * @param  minVal lower edge of the first bin
+  * @param  maxVal upper edge of the last bin
+  * @param  bins   pointer to bins (Cleared by this function)
+  * @param  nbins  number of bins
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail See BMP_RGB565_histogramFloat().
+  */
+int BMP_RGB565_histogramFloatROI(const float *pSrc, uint32_t stride, uint32_t width, uint32_t height,
+        float minVal, float maxVal, uint32_t *bins, uint32_t nbins)
+{
+    if (pSrc == NULL || bins == NULL || nbins == 0 || !(maxVal > minVal) || !isfinite(maxVal - minVal) || stride < width)
+        return -1;
 
-    /*
-    // without Black/White
-    int32_t ratio_buf = 4.0f * ratio;
-    uint8_t col_val = 127.5f * (-cosf(4.0f * M_PI * ratio) + 1.0f);
-         if (ratio_buf >= 4){r = 255;     g = 0;       b = 0;       }   // Red
-    else if (ratio_buf >= 3){r = 255;     g = col_val; b = 0;       }   // Yellow - Red
-    else if (ratio_buf >= 2){r = col_val; g = 255;     b = 0;       }   // Green - Yellow
-    else if (ratio_buf >= 1){r = 0;       g = 255;     b = col_val; }   // Sky - Green
-    else if (ratio_buf >= 0){r = 0;       g = col_val; b = 255;     }   // Blue - Sky
-    else                    {r = 0;       g = 0;       b = 255;     }   // Blue
-    */
+    float scale = nbins / (maxVal - minVal);
+    memset(bins, 0, nbins * sizeof(uint32_t));
 
-	return 0;
+    for (uint32_t y = 0; y < height; y++)
+        BMP_RGB565_histogramFloatRun(pSrc + (size_t)stride * y, width, minVal, scale, bins, nbins);
+    return 0;
 }
 
 
@@ -667,6 +2702,541 @@ static uint32_t BMP_RGB565_getBytesPerRow(uint32_t width)
 }
 
 
+// Reverse the order of the pixels of a row.
+static void BMP_RGB565_reverseRow(uint16_t *row, uint32_t width)
+{
+    for(uint32_t x = 0; x < width / 2; x++)
+    {
+        uint16_t tmp = row[x];
+        row[x] = row[width - x - 1];
+        row[width - x - 1] = tmp;
+    }
+}
+
+// Reverse the order of the rows [y_begin, y_end) of an image.
+static void BMP_RGB565_reverseRows(uint8_t *pbmp, uint32_t y_begin, uint32_t y_end)
+{
+    uint32_t width = BMP_RGB565_getWidth(pbmp);
+
+    while (y_end > y_begin + 1)
+    {
+        uint16_t *top    = BMP_RGB565_getRow(pbmp, y_begin++);
+        uint16_t *bottom = BMP_RGB565_getRow(pbmp, --y_end);
+        for (uint32_t x = 0; x < width; x++)
+        {
+            uint16_t tmp = top[x];
+            top[x] = bottom[x];
+            bottom[x] = tmp;
+        }
+    }
+}
+
+// Create a transposed copy of an image, processed in square tiles so that
+// both the source columns and the destination rows of a tile stay in cache.
+// Destination pixel (x, y) is taken from source pixel (y', x'), where
+//   y' = y, or (src_width  - 1 - y) when mirror_x is set,
+//   x' = x, or (src_height - 1 - x) when mirror_y is set.
+// Transpose: no mirror. Rotate 90 [deg]: mirror_y. Rotate 270 [deg]: mirror_x.
+static uint8_t *BMP_RGB565_transposeTiled(uint8_t *pbmpSrc, bool mirror_x, bool mirror_y)
+{
+    if(!BMP_RGB565_is565(pbmpSrc))
+        return NULL;
+
+    uint32_t src_width  = BMP_RGB565_getWidth(pbmpSrc);
+    uint32_t src_height = BMP_RGB565_getHeight(pbmpSrc);
+
+    uint8_t *pbmpDst = BMP_RGB565_create(src_height, src_width);
+    if(pbmpDst == NULL)
+        return NULL;
+
+    uint16_t *src_rows[BMP_RGB565_TILE_SIZE];
+
+    for(uint32_t tx = 0; tx < src_height; tx += BMP_RGB565_TILE_SIZE)
+    {
+        uint32_t tw = (src_height - tx < BMP_RGB565_TILE_SIZE) ? src_height - tx : BMP_RGB565_TILE_SIZE;
+
+        // Source rows feeding destination columns [tx, tx + tw)
+        for(uint32_t i = 0; i < tw; i++)
+            src_rows[i] = BMP_RGB565_getRow(pbmpSrc, mirror_y ? src_height - 1 - (tx + i) : tx + i);
+
+        for(uint32_t ty = 0; ty < src_width; ty += BMP_RGB565_TILE_SIZE)
+        {
+            uint32_t th = (src_width - ty < BMP_RGB565_TILE_SIZE) ? src_width - ty : BMP_RGB565_TILE_SIZE;
+
+            for(uint32_t j = 0; j < th; j++)
+            {
+                uint32_t y  = ty + j;
+                uint32_t sx = mirror_x ? src_width - 1 - y : y;
+                uint16_t *dst_row = BMP_RGB565_getRow(pbmpDst, y) + tx;
+                for(uint32_t i = 0; i < tw; i++)
+                    dst_row[i] = src_rows[i][sx];
+            }
+        }
+    }
+    return pbmpDst;
+}
+
+
+// Load row y of a view as planar 5/6/5-bit channel values.
+static void BMP_RGB565_filterLoadView(const void *src, uint32_t width, uint32_t y, float *row)
+{
+    const uint16_t *pixels = BMP_RGB565_viewGetRow((const BMP_RGB565_view_st *)src, y);
+    for (uint32_t x = 0; x < width; x++)
+    {
+        uint16_t col = BMP_RGB565_get565(pixels, x);
+        row[x]             = (float)(col >> 11);
+        row[width + x]     = (float)((col >> 5) & 0x3F);
+        row[width * 2 + x] = (float)(col & 0x1F);
+    }
+}
+
+// Store planar channel values to row y of a view.
+static void BMP_RGB565_filterStoreView(void *dst, uint32_t width, uint32_t y, const float *row)
+{
+    uint16_t *pixels = BMP_RGB565_viewGetRow((const BMP_RGB565_view_st *)dst, y);
+    for (uint32_t x = 0; x < width; x++)
+    {
+        int32_t r = (int32_t)(row[x] + 0.5f);
+        int32_t g = (int32_t)(row[width + x] + 0.5f);
+        int32_t b = (int32_t)(row[width * 2 + x] + 0.5f);
+        BMP_RGB565_put565(pixels, x, (uint16_t)((RANGE(r, 0, 31) << 11) | (RANGE(g, 0, 63) << 5) | RANGE(b, 0, 31)));
+    }
+}
+
+static void BMP_RGB565_filterLoadFloat(const void *src, uint32_t width, uint32_t y, float *row)
+{
+    memcpy(row, (const float *)src + (size_t)width * y, width * sizeof(float));
+}
+
+static void BMP_RGB565_filterStoreFloat(void *dst, uint32_t width, uint32_t y, const float *row)
+{
+    memcpy((float *)dst + (size_t)width * y, row, width * sizeof(float));
+}
+
+// Accumulate minimum, maximum, sum and number of the finite values.
+static void BMP_RGB565_statsFloatRun(const float *pSrc, uint32_t n, float *pMin, float *pMax, double *pSum, uint64_t *pCount)
+{
+    float vmin[BMP_RGB565_STATS_LANES], vmax[BMP_RGB565_STATS_LANES], vsum[BMP_RGB565_STATS_LANES];
+    uint32_t vcount[BMP_RGB565_STATS_LANES];
+    float min = *pMin, max = *pMax;
+    double sum = 0.0;
+    uint64_t count = 0;
+    uint32_t i = 0;
+
+    for (int k = 0; k < BMP_RGB565_STATS_LANES; k++)
+    {
+        vmin[k] = min;
+        vmax[k] = max;
+    }
+
+    while (i + BMP_RGB565_STATS_LANES <= n)
+    {
+        // Partial sums in float are flushed to double every block to limit rounding error
+        uint32_t block_end = i + BMP_RGB565_STATS_BLOCK;
+        if (block_end > n)
+            block_end = n;
+
+        for (int k = 0; k < BMP_RGB565_STATS_LANES; k++)
+        {
+            vsum[k] = 0.0f;
+            vcount[k] = 0;
+        }
+        for (; i + BMP_RGB565_STATS_LANES <= block_end; i += BMP_RGB565_STATS_LANES)
+        {
+            for (int k = 0; k < BMP_RGB565_STATS_LANES; k++)
+            {
+                // Branchless select keeps the loop vectorizable
+                float v = pSrc[i + k];
+                bool finite = isfinite(v);
+                vmin[k] = (finite && v < vmin[k]) ? v : vmin[k];
+                vmax[k] = (finite && v > vmax[k]) ? v : vmax[k];
+                vsum[k] += finite ? v : 0.0f;
+                vcount[k] += finite;
+            }
+        }
+        for (int k = 0; k < BMP_RGB565_STATS_LANES; k++)
+        {
+            sum += vsum[k];
+            count += vcount[k];
+        }
+    }
+
+    for (int k = 0; k < BMP_RGB565_STATS_LANES; k++)
+    {
+        min = (vmin[k] < min) ? vmin[k] : min;
+        max = (vmax[k] > max) ? vmax[k] : max;
+    }
+    for (; i < n; i++)
+    {
+        if (!isfinite(pSrc[i]))
+            continue;
+        min = (pSrc[i] < min) ? pSrc[i] : min;
+        max = (pSrc[i] > max) ? pSrc[i] : max;
+        sum += pSrc[i];
+        count++;
+    }
+
+    *pMin = min;
+    *pMax = max;
+    *pSum += sum;
+    *pCount += count;
+}
+
+// Count the finite values into bins. scale = nbins / (maxVal - minVal)
+static void BMP_RGB565_histogramFloatRun(const float *pSrc, uint32_t n, float minVal, float scale, uint32_t *bins, uint32_t nbins)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (!isfinite(pSrc[i]))
+            continue;
+        float pos = (pSrc[i] - minVal) * scale;
+        uint32_t bin = !(pos > 0.0f) ? 0 : (pos >= (float)nbins) ? nbins - 1 : (uint32_t)pos;    // NaN (0 * Inf scale) goes to bin 0
+        bins[bin]++;
+    }
+}
+
+// Median of 9 values by a sorting network.
+// ref : http://ndevilla.free.fr/median/median/
+static float BMP_RGB565_median9(float *p)
+{
+#define BMP_RGB565_SORT2(a, b) { if (p[a] > p[b]) { float t = p[a]; p[a] = p[b]; p[b] = t; } }
+    BMP_RGB565_SORT2(1, 2); BMP_RGB565_SORT2(4, 5); BMP_RGB565_SORT2(7, 8);
+    BMP_RGB565_SORT2(0, 1); BMP_RGB565_SORT2(3, 4); BMP_RGB565_SORT2(6, 7);
+    BMP_RGB565_SORT2(1, 2); BMP_RGB565_SORT2(4, 5); BMP_RGB565_SORT2(7, 8);
+    BMP_RGB565_SORT2(0, 3); BMP_RGB565_SORT2(5, 8); BMP_RGB565_SORT2(4, 7);
+    BMP_RGB565_SORT2(3, 6); BMP_RGB565_SORT2(1, 4); BMP_RGB565_SORT2(2, 5);
+    BMP_RGB565_SORT2(4, 7); BMP_RGB565_SORT2(4, 2); BMP_RGB565_SORT2(6, 4);
+    BMP_RGB565_SORT2(4, 2);
+#undef BMP_RGB565_SORT2
+    return p[4];
+}
+
+// Run a filter on rows [y_begin, y_end).
+// Source rows are loaded in ascending order into a ring of (2r + 2) row buffers, after the
+// horizontal pass for separable filters, or padded by one pixel for 3x3 filters.
+// Output row y is stored only after every source row it depends on has been loaded,
+// so a full-frame run may write to its own source.
+static int BMP_RGB565_filterRun(const BMP_RGB565_filterIO_st *io, BMP_RGB565_filter_t type, float param,
+        uint32_t y_begin, uint32_t y_end)
+{
+    uint32_t width = io->width, height = io->height, channels = io->channels;
+    uint32_t r, pad;
+    float *kernel = NULL;
+
+    if (width == 0 || y_begin >= y_end || y_end > height)
+        return -1;
+
+    switch (type)
+    {
+    case BMP_RGB565_FILTER_BOX:
+        if (!(param >= 0.0f) || param > BMP_RGB565_FILTER_MAX_RADIUS)
+            return -1;
+        r = (uint32_t)param;
+        pad = 0;
+        break;
+    case BMP_RGB565_FILTER_GAUSSIAN:
+        if (!(param > 0.0f) || 3.0f * param > BMP_RGB565_FILTER_MAX_RADIUS)
+            return -1;
+        r = (uint32_t)ceilf(3.0f * param);
+        pad = 0;
+        break;
+    case BMP_RGB565_FILTER_SHARPEN:
+    case BMP_RGB565_FILTER_MEDIAN3X3:
+        r = 1;
+        pad = 1;
+        break;
+    default:
+        return -1;
+    }
+
+    uint32_t stride = width + 2 * pad;                     // per channel
+    uint32_t slots  = (2 * r + 2 < height) ? 2 * r + 2 : height;
+    size_t ring_size = (size_t)slots * channels * stride;
+    size_t line_size = (size_t)width + 2 * r;
+    size_t row_size  = (size_t)width * channels;
+
+    float *buf = (float *)bmp_rgb565_malloc(sizeof(float) * (ring_size + line_size + row_size * 3 + 2 * r + 1));
+    if (buf == NULL)
+        return -1;
+    float *ring   = buf;
+    float *line   = ring + ring_size;
+    float *in     = line + line_size;
+    float *out    = in + row_size;
+    float *colsum = out + row_size;
+    kernel        = colsum + row_size;
+
+    if (type == BMP_RGB565_FILTER_GAUSSIAN)
+    {
+        float sum = 0.0f;
+        for (uint32_t i = 0; i <= 2 * r; i++)
+        {
+            float d = (float)i - (float)r;
+            kernel[i] = expf(-d * d / (2.0f * param * param));
+            sum += kernel[i];
+        }
+        for (uint32_t i = 0; i <= 2 * r; i++)
+            kernel[i] /= sum;
+    }
+
+#define BMP_RGB565_RING_ROW(_Y_, _C_) (ring + ((size_t)((_Y_) % slots) * channels + (_C_)) * stride)
+#define BMP_RGB565_CLAMP_ROW(_Y_)     ((_Y_) < 0 ? 0 : ((_Y_) >= (int64_t)height ? height - 1 : (uint32_t)(_Y_)))
+
+    uint32_t next = BMP_RGB565_CLAMP_ROW((int64_t)y_begin - r);
+    float inv_box = 1.0f / (2 * r + 1);
+
+    for (uint32_t y = y_begin; y < y_end; y++)
+    {
+        // Load every source row up to y + r + 1
+        uint32_t last = BMP_RGB565_CLAMP_ROW((int64_t)y + r + 1);
+        for (; next <= last; next++)
+        {
+            io->load(io->src, width, next, in);
+            for (uint32_t c = 0; c < channels; c++)
+            {
+                const float *src = in + (size_t)c * width;
+                float *dst = BMP_RGB565_RING_ROW(next, c);
+
+                if (pad > 0)
+                {
+                    memcpy(dst + pad, src, width * sizeof(float));
+                    dst[0] = src[0];
+                    dst[width + 1] = src[width - 1];
+                    continue;
+                }
+
+                // Horizontal pass on an edge-replicated line
+                for (uint32_t i = 0; i < r; i++)
+                {
+                    line[i] = src[0];
+                    line[r + width + i] = src[width - 1];
+                }
+                memcpy(line + r, src, width * sizeof(float));
+
+                if (type == BMP_RGB565_FILTER_BOX)
+                {
+                    float sum = 0.0f;
+                    for (uint32_t i = 0; i < 2 * r; i++)
+                        sum += line[i];
+                    for (uint32_t x = 0; x < width; x++)
+                    {
+                        sum += line[x + 2 * r];
+                        dst[x] = sum * inv_box;
+                        sum -= line[x];
+                    }
+                }
+                else
+                {
+                    for (uint32_t x = 0; x < width; x++)
+                        dst[x] = 0.0f;
+                    for (uint32_t i = 0; i <= 2 * r; i++)
+                        for (uint32_t x = 0; x < width; x++)
+                            dst[x] += kernel[i] * line[x + i];
+                }
+            }
+        }
+
+        // Vertical pass / 3x3 operation
+        for (uint32_t c = 0; c < channels; c++)
+        {
+            float *o = out + (size_t)c * width;
+            float *s = colsum + (size_t)c * width;
+
+            if (type == BMP_RGB565_FILTER_BOX)
+            {
+                if (y == y_begin)
+                {
+                    for (uint32_t x = 0; x < width; x++)
+                        s[x] = 0.0f;
+                    for (int64_t i = -(int64_t)r; i <= (int64_t)r; i++)
+                    {
+                        const float *row = BMP_RGB565_RING_ROW(BMP_RGB565_CLAMP_ROW((int64_t)y + i), c);
+                        for (uint32_t x = 0; x < width; x++)
+                            s[x] += row[x];
+                    }
+                }
+                const float *add = BMP_RGB565_RING_ROW(BMP_RGB565_CLAMP_ROW((int64_t)y + r + 1), c);
+                const float *sub = BMP_RGB565_RING_ROW(BMP_RGB565_CLAMP_ROW((int64_t)y - r), c);
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    o[x] = s[x] * inv_box;
+                    s[x] += add[x] - sub[x];
+                }
+            }
+            else if (type == BMP_RGB565_FILTER_GAUSSIAN)
+            {
+                for (uint32_t x = 0; x < width; x++)
+                    o[x] = 0.0f;
+                for (uint32_t i = 0; i <= 2 * r; i++)
+                {
+                    const float *row = BMP_RGB565_RING_ROW(BMP_RGB565_CLAMP_ROW((int64_t)y + i - r), c);
+                    for (uint32_t x = 0; x < width; x++)
+                        o[x] += kernel[i] * row[x];
+                }
+            }
+            else
+            {
+                const float *u = BMP_RGB565_RING_ROW(BMP_RGB565_CLAMP_ROW((int64_t)y - 1), c);
+                const float *m = BMP_RGB565_RING_ROW(y, c);
+                const float *d = BMP_RGB565_RING_ROW(BMP_RGB565_CLAMP_ROW((int64_t)y + 1), c);
+
+                if (type == BMP_RGB565_FILTER_SHARPEN)
+                {
+                    for (uint32_t x = 0; x < width; x++)
+                        o[x] = 5.0f * m[x + 1] - m[x] - m[x + 2] - u[x + 1] - d[x + 1];
+                }
+                else
+                {
+                    float p[9];
+                    for (uint32_t x = 0; x < width; x++)
+                    {
+                        p[0] = u[x]; p[1] = u[x + 1]; p[2] = u[x + 2];
+                        p[3] = m[x]; p[4] = m[x + 1]; p[5] = m[x + 2];
+                        p[6] = d[x]; p[7] = d[x + 1]; p[8] = d[x + 2];
+                        o[x] = BMP_RGB565_median9(p);
+                    }
+                }
+            }
+        }
+        io->store(io->dst, width, y, out);
+    }
+
+#undef BMP_RGB565_RING_ROW
+#undef BMP_RGB565_CLAMP_ROW
+
+    bmp_rgb565_free(buf);
+    return 0;
+}
+
+// Calculate the number of bytes used to store a single row of an indexed color image.
+// This is always rounded up to the next multiple of 4.
+static uint32_t BMP_RGB565_getIndexedBytesPerRow(uint32_t width, uint32_t bits)
+{
+    return (uint32_t)((((uint64_t)width * bits + 31) / 32) * 4);
+}
+
+// Check that an image is a RGB565 image (16 bits per pixel).
+static bool BMP_RGB565_is565(uint8_t *pbmp)
+{
+    return pbmp != NULL && BMP_RGB565_getBitCount(pbmp) == 16;
+}
+
+// Check that an image is an indexed color image (4 or 8 bits per pixel).
+static bool BMP_RGB565_isIndexed(uint8_t *pbmp)
+{
+    uint32_t bits = BMP_RGB565_getBitCount(pbmp);
+    return bits == 4 || bits == 8;
+}
+
+// Calculate the address of the first byte of a row of an indexed color image.
+static uint8_t *BMP_RGB565_getIndexedRowAddr(uint8_t *pbmp, uint32_t y)
+{
+    uint32_t bytes_per_row = BMP_RGB565_getIndexedBytesPerRow(BMP_RGB565_getWidth(pbmp), BMP_RGB565_getBitCount(pbmp));
+    int32_t  height = (int32_t)BMP_RGB565_read_uint32_t(pbmp + BMP_RGB565_FILE_HEADER_SIZE + 0x08);
+    uint8_t *pixels = pbmp + BMP_RGB565_getOffset(pbmp);
+
+    if (height < 0)
+        return pixels + (size_t)bytes_per_row * y;
+    else
+        return pixels + (size_t)bytes_per_row * ((uint32_t)height - y - 1);
+}
+
+// Write a palette index on a pixel of a row. (No range check)
+static void BMP_RGB565_putIndex(uint8_t *row, uint32_t x, uint32_t bits, uint8_t index)
+{
+    if (bits == 8)
+        row[x] = index;
+    else if (x & 1)
+        row[x >> 1] = (row[x >> 1] & 0xF0) | (index & 0x0F);
+    else
+        row[x >> 1] = (row[x >> 1] & 0x0F) | (uint8_t)(index << 4);
+}
+
+// Row access and pixel write of text destinations (see BMP_RGB565_textIO_st).
+static void *BMP_RGB565_textViewRow(const void *dst, uint32_t y)
+{
+    return BMP_RGB565_viewGetRow((const BMP_RGB565_view_st *)dst, y);
+}
+
+static void *BMP_RGB565_textIndexedRow(const void *dst, uint32_t y)
+{
+    return BMP_RGB565_getIndexedRowAddr((uint8_t *)dst, y);
+}
+
+static void BMP_RGB565_textPut565(void *row, uint32_t x, uint32_t bits, uint32_t value)
+{
+    (void)bits;
+    BMP_RGB565_put565((uint16_t *)row, x, (uint16_t)value);
+}
+
+static void BMP_RGB565_textPutIndex(void *row, uint32_t x, uint32_t bits, uint32_t value)
+{
+    BMP_RGB565_putIndex((uint8_t *)row, x, bits, (uint8_t)value);
+}
+
+// Draw the set pixels of the glyphs of text, clipped to the destination.
+static void BMP_RGB565_textRun(const BMP_RGB565_textIO_st *io, const char *text, BMP_RGB565_font_st font,
+    int64_t x_start, int64_t y_start)
+{
+    size_t len = strlen(text);
+    int64_t x, y;
+    int bytesPerChar = font.char_width / 8;
+    if(font.char_width % 8 > 0)
+        bytesPerChar++;
+
+    for(size_t i = 0; i < len; i++)
+    {
+        uint8_t c = (uint8_t)*(text + i);
+
+        for(int yTxt = 0; yTxt < font.char_height; yTxt++)
+        {
+            y = y_start + yTxt;
+            if(y < 0)
+                continue;
+            if(y >= io->height)
+                break;
+            void *row = io->getRow(io->dst, (uint32_t)y);
+            for(int xTxt = 0; xTxt < font.char_width; xTxt++)
+            {
+                x = x_start + (int64_t)i * font.char_width + xTxt;
+                if(x < 0)
+                    continue;
+                if(x >= io->width)
+                    break;
+
+                uint8_t buf = *(font.p + c * bytesPerChar * font.char_height
+                            + yTxt * bytesPerChar
+                            + (bytesPerChar - 1) - (xTxt >> 3));
+                if(buf & (0x80 >> (xTxt & 0x07)))
+                    io->put(row, (uint32_t)x, io->bits, io->value);
+            }
+        }
+    }
+}
+
+// Get a color in RGB format on a pixel of a view. (No range check)
+// Same conversion as BMP_RGB565_getPixelRGB().
+static void BMP_RGB565_viewGetRGB(const BMP_RGB565_view_st *view, uint32_t x, uint32_t y, uint8_t *rgb)
+{
+    uint16_t col = BMP_RGB565_get565(BMP_RGB565_viewGetRow(view, y), x);
+    rgb[0] = (uint8_t)(col >> 11) << 3; if(rgb[0] == 0xF8) rgb[0] = 0xFF;
+    rgb[1] = (uint8_t)(col >>  5) << 2; if(rgb[1] == 0xFC) rgb[1] = 0xFF;
+    rgb[2] = (uint8_t) col        << 3; if(rgb[2] == 0xF8) rgb[2] = 0xFF;
+}
+
+// Calculate the address of the first byte of a row.
+// Bottom-up images (positive height) store the last row first.
+static uint8_t *BMP_RGB565_getRowAddr(uint8_t *pbmp, uint32_t y)
+{
+    uint32_t bytes_per_row = BMP_RGB565_getBytesPerRow(BMP_RGB565_getWidth(pbmp));
+    int32_t  height = (int32_t)BMP_RGB565_read_uint32_t(pbmp + BMP_RGB565_FILE_HEADER_SIZE + 0x08);
+
+    if (height < 0)
+        return pbmp + AllHeaderOffset + (size_t)bytes_per_row * y;
+    else
+        return pbmp + AllHeaderOffset + (size_t)bytes_per_row * ((uint32_t)height - y - 1);
+}
+
+
 /**************************************************************
     Reads a little-endian unsigned int from the file.
     Returns non-zero on success.
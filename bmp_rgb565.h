@@ -8,6 +8,7 @@ extern "C"
 #endif
 
 /* Include system header files -----------------------------------------------*/
+#include <stddef.h>
 #include <stdint.h>
 
 /* Include user header files -------------------------------------------------*/
@@ -32,6 +33,11 @@ extern "C"
 // #define USE_FONT_24X40
 // #define USE_FONT_32X53
 
+/** @def
+ * Size of the header (file header + info header + bit fields) of a BMP RGB565 image [byte]
+ */
+#define BMP_RGB565_HEADER_SIZE  70
+
 #ifndef COLOR_R
 #define COLOR_R(_C_COLOR_) (uint8_t)((_C_COLOR_) >> 16)
 #endif
@@ -44,15 +50,113 @@ extern "C"
 #ifndef COL_RGB_SET
 #define COL_RGB_SET(_C_COLOR_) COLOR_R(_C_COLOR_), COLOR_G(_C_COLOR_), COLOR_B(_C_COLOR_)
 #endif
+#ifndef COL_RGB565
+#define COL_RGB565(_C_COLOR_) BMP_RGB565_toRGB565(COL_RGB_SET(_C_COLOR_))
+#endif
 
 /* Exported function macro ---------------------------------------------------*/
+/**
+  * @brief  Convert a color in RGB format to RGB565.
+  * @param  r	Red   value [0, 255] (Lower 3 bits are ignored)
+  * @param  g	Green value [0, 255] (Lower 2 bits are ignored)
+  * @param  b	Blue  value [0, 255] (Lower 3 bits are ignored)
+  * @retval RGB565 color
+  */
+static inline uint16_t BMP_RGB565_toRGB565(uint8_t r, uint8_t g, uint8_t b)
+{
+    return  ((uint16_t) (r >> 3) << 11)
+          | ((uint16_t) (g >> 2) << 5)
+          |  (uint16_t) (b >> 3);
+}
+
+/**
+  * @brief  Draw a RGB565 color on a pixel of a row. (No range check)
+  * @param  row	pointer to a row (see BMP_RGB565_getRow())
+  * @param  x	x of a image(Range:[0,width-1] ) [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  */
+static inline void BMP_RGB565_put565(uint16_t *row, uint32_t x, uint16_t col)
+{
+    uint8_t *p = (uint8_t *)(row + x);
+    p[0] = (uint8_t) col;
+    p[1] = (uint8_t)(col >> 8);
+}
+
+/**
+  * @brief  Get a RGB565 color on a pixel of a row. (No range check)
+  * @param  row	pointer to a row (see BMP_RGB565_getRow())
+  * @param  x	x of a image(Range:[0,width-1] ) [pixel]
+  * @retval RGB565 color
+  */
+static inline uint16_t BMP_RGB565_get565(const uint16_t *row, uint32_t x)
+{
+    const uint8_t *p = (const uint8_t *)(row + x);
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
 /* Exported types ------------------------------------------------------------*/
 typedef void *(*BMP_RGB565_Malloc_Function)(size_t);
 typedef void (*BMP_RGB565_free_Function)(void *);
 
 /* Exported enum tag ---------------------------------------------------------*/
+/**
+ * Filter types of BMP_RGB565_filter()
+ */
+typedef enum
+{
+   BMP_RGB565_FILTER_BOX,        // Box blur by running sums (param: radius [pixel])
+   BMP_RGB565_FILTER_GAUSSIAN,   // Separable Gaussian blur (param: sigma [pixel])
+   BMP_RGB565_FILTER_SHARPEN,    // 3x3 sharpen
+   BMP_RGB565_FILTER_MEDIAN3X3,  // 3x3 median
+} BMP_RGB565_filter_t;
 
 /* Exported struct/union tag -------------------------------------------------*/
+/**
+ * Ring buffer (virtual origin) over an image, for strip charts and waterfalls
+ */
+typedef struct
+{
+   uint8_t *pbmp;       // image holding the pixels
+   uint32_t x_origin;   // physical x of logical x = 0 [pixel]
+   uint32_t y_origin;   // physical y of logical y = 0 [pixel]
+} BMP_RGB565_ring_st;
+
+/**
+ * View of a rectangular region of an image (see BMP_RGB565_viewInit()).
+ * A view does not own its pixels: it points into the parent image, so drawing on a
+ * view draws on the parent.
+ */
+typedef struct
+{
+   uint8_t *data;       // address of the upper left pixel of the region
+   ptrdiff_t stride;    // bytes from a row to the next row (negative for bottom-up images)
+   uint32_t x;          // x of the region in the parent image [pixel]
+   uint32_t y;          // y of the region in the parent image [pixel]
+   uint32_t width;      // [pixel]
+   uint32_t height;     // [pixel]
+} BMP_RGB565_view_st;
+
+/**
+ * Statistics of a frame
+ */
+typedef struct
+{
+   float min;
+   float max;
+   float mean;
+} BMP_RGB565_stats_st;
+
+/**
+ * Display range for BMP_RGB565_colorScale(), smoothed across frames
+ */
+typedef struct
+{
+   float minVal;
+   float maxVal;
+   uint8_t valid;       // 0: not initialized (next update is taken as is)
+} BMP_RGB565_range_st;
+
 /* Exported variables --------------------------------------------------------*/
     /** 
  * Font source : https://www.mikrocontroller.net/user/show/benedikt
@@ -65,6 +169,18 @@ typedef struct
    int8_t char_height;
 } BMP_RGB565_font_st;
 
+/**
+ * Packed 1bpp font loaded at runtime (see BMP_RGB565_loadPackedFont())
+ */
+typedef struct
+{
+   const uint8_t *p;    // packed font blob
+   uint8_t char_width;
+   uint8_t char_height;
+   uint16_t first;      // first character code
+   uint16_t count;      // number of character codes
+} BMP_RGB565_packedFont_st;
+
 
 #ifdef USE_FONT_4X6
 extern const BMP_RGB565_font_st BMP_RGB565_FONT_4X6;
@@ -118,6 +234,9 @@ extern const BMP_RGB565_font_st BMP_RGB565_FONT_32X53;
 /* Exported function prototypes ----------------------------------------------*/
 extern void BMP_RGB565_setAllocFunc(BMP_RGB565_Malloc_Function, BMP_RGB565_free_Function);
 extern uint8_t *BMP_RGB565_create(uint32_t, uint32_t);
+extern uint32_t BMP_RGB565_calcFileSize(uint32_t, uint32_t);
+extern void BMP_RGB565_init(uint8_t *, uint32_t, uint32_t);
+extern int BMP_RGB565_initHeader(uint8_t *, uint32_t, uint32_t);
 extern void BMP_RGB565_free(uint8_t *);
 extern uint32_t BMP_RGB565_getWidth(uint8_t *);
 extern uint32_t BMP_RGB565_getHeight(uint8_t *);
@@ -132,7 +251,78 @@ extern void BMP_RGB565_fillRGB(uint8_t *, uint8_t, uint8_t, uint8_t);
 extern uint8_t * BMP_RGB565_copy(uint8_t *);
 extern void BMP_RGB565_drawTextRGB(uint8_t *, char *, BMP_RGB565_font_st, uint32_t, uint32_t, uint8_t, uint8_t, uint8_t);
 extern uint8_t *BMP_RGB565_resize_bicubic(uint8_t *, uint32_t, uint32_t);
+extern uint8_t *BMP_RGB565_rotate90(uint8_t *);
+extern uint8_t *BMP_RGB565_rotate270(uint8_t *);
+extern uint8_t *BMP_RGB565_transpose(uint8_t *);
+extern void BMP_RGB565_rotate180(uint8_t *);
+extern void BMP_RGB565_flipHorizontal(uint8_t *);
+extern void BMP_RGB565_flipVertical(uint8_t *);
+extern void BMP_RGB565_scrollRGB(uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, int32_t, int32_t, uint8_t, uint8_t, uint8_t);
+extern void BMP_RGB565_scroll565(uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, int32_t, int32_t, uint16_t);
+extern void BMP_RGB565_ringInit(BMP_RGB565_ring_st *, uint8_t *);
+extern void BMP_RGB565_ringScroll565(BMP_RGB565_ring_st *, int32_t, int32_t, uint16_t);
+extern uint16_t *BMP_RGB565_ringGetRow(BMP_RGB565_ring_st *, uint32_t);
+extern void BMP_RGB565_ringSetPixel565(BMP_RGB565_ring_st *, uint32_t, uint32_t, uint16_t);
+extern uint16_t BMP_RGB565_ringGetPixel565(BMP_RGB565_ring_st *, uint32_t, uint32_t);
+extern void BMP_RGB565_ringFlatten(BMP_RGB565_ring_st *);
+extern int BMP_RGB565_statsFloat(const float *, uint32_t, BMP_RGB565_stats_st *);
+extern int BMP_RGB565_statsUint16(const uint16_t *, uint32_t, BMP_RGB565_stats_st *);
+extern int BMP_RGB565_histogramFloat(const float *, uint32_t, float, float, uint32_t *, uint32_t);
+extern int BMP_RGB565_histogramUint16(const uint16_t *, uint32_t, uint16_t, uint16_t, uint32_t *, uint32_t);
+extern float BMP_RGB565_histogramPercentile(const uint32_t *, uint32_t, float, float, float);
+extern void BMP_RGB565_rangeUpdate(BMP_RGB565_range_st *, float, float, float);
+extern int BMP_RGB565_autoRangeFloat(const float *, uint32_t, float, float, float, BMP_RGB565_range_st *);
+extern int BMP_RGB565_autoRangeUint16(const uint16_t *, uint32_t, float, float, float, BMP_RGB565_range_st *);
+extern int BMP_RGB565_filter(uint8_t *, uint8_t *, BMP_RGB565_filter_t, float);
+extern int BMP_RGB565_filterBand(uint8_t *, uint8_t *, BMP_RGB565_filter_t, float, uint32_t, uint32_t);
+extern int BMP_RGB565_filterFloat(const float *, float *, uint32_t, uint32_t, BMP_RGB565_filter_t, float);
+extern int BMP_RGB565_filterFloatBand(const float *, float *, uint32_t, uint32_t, BMP_RGB565_filter_t, float, uint32_t, uint32_t);
 extern int BMP_RGB565_colorScale(float, float, float, uint8_t *, uint8_t *, uint8_t *);
+extern uint8_t *BMP_RGB565_createIndexed(uint32_t, uint32_t, uint32_t);
+extern uint32_t BMP_RGB565_calcIndexedFileSize(uint32_t, uint32_t, uint32_t);
+extern uint32_t BMP_RGB565_getBitCount(uint8_t *);
+extern int BMP_RGB565_setPaletteEntry(uint8_t *, uint32_t, uint8_t, uint8_t, uint8_t);
+extern int BMP_RGB565_setColorScalePalette(uint8_t *, uint32_t);
+extern uint32_t BMP_RGB565_getPalette565(uint8_t *, uint16_t *);
+extern uint8_t BMP_RGB565_valueToIndex(float, float, float, uint32_t);
+extern int BMP_RGB565_valuesToIndexed(uint8_t *, const float *, float, float, uint32_t);
+extern int BMP_RGB565_expandIndexed(uint8_t *, uint8_t *);
+extern uint8_t *BMP_RGB565_getIndexedRow(uint8_t *, uint32_t);
+extern void BMP_RGB565_setPixelIndex(uint8_t *, uint32_t, uint32_t, uint8_t);
+extern uint8_t BMP_RGB565_getPixelIndex(uint8_t *, uint32_t, uint32_t);
+extern void BMP_RGB565_drawLineIndex(uint8_t *, int32_t, int32_t, int32_t, int32_t, uint8_t);
+extern void BMP_RGB565_drawRectIndex(uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, uint8_t);
+extern void BMP_RGB565_fillIndex(uint8_t *, uint8_t);
+extern void BMP_RGB565_drawTextIndex(uint8_t *, const char *, BMP_RGB565_font_st, uint32_t, uint32_t, uint8_t);
+extern int BMP_RGB565_viewInit(BMP_RGB565_view_st *, uint8_t *, int32_t, int32_t, uint32_t, uint32_t);
+extern int BMP_RGB565_viewSub(BMP_RGB565_view_st *, const BMP_RGB565_view_st *, int32_t, int32_t, uint32_t, uint32_t);
+extern uint16_t *BMP_RGB565_viewGetRow(const BMP_RGB565_view_st *, uint32_t);
+extern void BMP_RGB565_viewSetPixel565(const BMP_RGB565_view_st *, int32_t, int32_t, uint16_t);
+extern uint16_t BMP_RGB565_viewGetPixel565(const BMP_RGB565_view_st *, int32_t, int32_t);
+extern void BMP_RGB565_viewDrawLine565(const BMP_RGB565_view_st *, int32_t, int32_t, int32_t, int32_t, uint16_t);
+extern void BMP_RGB565_viewDrawRect565(const BMP_RGB565_view_st *, int32_t, int32_t, int32_t, int32_t, uint16_t);
+extern void BMP_RGB565_viewFill565(const BMP_RGB565_view_st *, uint16_t);
+extern void BMP_RGB565_viewDrawText565(const BMP_RGB565_view_st *, const char *, BMP_RGB565_font_st, int32_t, int32_t, uint16_t);
+extern void BMP_RGB565_viewBlit(const BMP_RGB565_view_st *, const BMP_RGB565_view_st *, int32_t, int32_t);
+extern int BMP_RGB565_viewResizeBicubic(const BMP_RGB565_view_st *, const BMP_RGB565_view_st *);
+extern int BMP_RGB565_viewFilter(const BMP_RGB565_view_st *, const BMP_RGB565_view_st *, BMP_RGB565_filter_t, float);
+extern int BMP_RGB565_viewFilterBand(const BMP_RGB565_view_st *, const BMP_RGB565_view_st *, BMP_RGB565_filter_t, float, uint32_t, uint32_t);
+extern uint8_t *BMP_RGB565_viewToImage(const BMP_RGB565_view_st *);
+extern int BMP_RGB565_statsFloatROI(const float *, uint32_t, uint32_t, uint32_t, BMP_RGB565_stats_st *);
+extern int BMP_RGB565_statsUint16ROI(const uint16_t *, uint32_t, uint32_t, uint32_t, BMP_RGB565_stats_st *);
+extern int BMP_RGB565_histogramFloatROI(const float *, uint32_t, uint32_t, uint32_t, float, float, uint32_t *, uint32_t);
+extern uint16_t *BMP_RGB565_getRow(uint8_t *, uint32_t);
+extern void BMP_RGB565_setPixel565(uint8_t *, uint32_t, uint32_t, uint16_t);
+extern uint16_t BMP_RGB565_getPixel565(uint8_t *, uint32_t, uint32_t);
+extern void BMP_RGB565_drawLine565(uint8_t *, int32_t, int32_t, int32_t, int32_t, uint16_t);
+extern void BMP_RGB565_drawRect565(uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, uint16_t);
+extern void BMP_RGB565_fill565(uint8_t *, uint16_t);
+extern void BMP_RGB565_drawText565(uint8_t *, const char *, BMP_RGB565_font_st, uint32_t, uint32_t, uint16_t);
+extern int BMP_RGB565_loadPackedFont(const uint8_t *, size_t, BMP_RGB565_packedFont_st *);
+extern size_t BMP_RGB565_packFont(BMP_RGB565_font_st, uint8_t, uint8_t, const char *, uint8_t *, size_t);
+extern void BMP_RGB565_drawTextPacked565(uint8_t *, const char *, const BMP_RGB565_packedFont_st *, uint32_t, uint32_t, uint16_t);
+extern void BMP_RGB565_measureText(const char *, BMP_RGB565_font_st, uint32_t *, uint32_t *);
+extern void BMP_RGB565_measureTextPacked(const char *, const BMP_RGB565_packedFont_st *, uint32_t *, uint32_t *);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,327 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef _BMP_RGB565_HPP_
+#define _BMP_RGB565_HPP_
+
+/**
+ * Header-only C++ layer over bmp_rgb565.h (C++14 or later).
+ *
+ *   bmp565::Bitmap<W, H, TopDown> : fixed-size image. Dimensions, stride and file size
+ *                                   are compile-time constants and the pixels live in
+ *                                   the object itself (no heap allocation).
+ *   bmp565::Image                 : runtime-size image owning a BMP_RGB565_create() buffer.
+ *                                   Move-only.
+ *
+ * Both keep the same 70-byte header layout as the C library, so data() can be passed to
+ * any BMP_RGB565_* function or written to a file as is.
+ */
+
+/* Include system header files -----------------------------------------------*/
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#define BMP_RGB565_HAS_SPAN
+#endif
+#endif
+
+/* Include user header files -------------------------------------------------*/
+#include "bmp_rgb565.h"
+
+namespace bmp565
+{
+
+/* Exported constants --------------------------------------------------------*/
+constexpr uint32_t FILE_HEADER_SIZE = 14;
+constexpr uint32_t INFO_HEADER_SIZE = 40;
+constexpr uint32_t BIT_FIELD_SIZE   = 16;
+constexpr uint32_t HEADER_SIZE      = FILE_HEADER_SIZE + INFO_HEADER_SIZE + BIT_FIELD_SIZE;
+
+/* Exported functions --------------------------------------------------------*/
+/** Number of bytes of a row (rounded up to a multiple of 4). */
+constexpr uint32_t bytesPerRow(uint32_t width) { return ((width + 1) & ~1u) << 1; }
+
+/** Number of bytes of the pixel data. */
+constexpr uint32_t imageSize(uint32_t width, uint32_t height) { return bytesPerRow(width) * height; }
+
+/** Number of bytes of a whole file (header + pixel data). */
+constexpr uint32_t fileSize(uint32_t width, uint32_t height) { return HEADER_SIZE + imageSize(width, height); }
+
+/** Convert a 0xRRGGBB color to RGB565. */
+constexpr uint16_t rgb565(uint32_t color)
+{
+    return (uint16_t)((((color >> 19) & 0x1F) << 11) | (((color >> 10) & 0x3F) << 5) | ((color >> 3) & 0x1F));
+}
+
+namespace detail
+{
+inline void write_uint16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+inline void write_uint32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+// Same layout as BMP_RGB565_create(). A top-down image stores a negative height.
+inline void writeHeader(uint8_t *p, uint32_t width, uint32_t height, bool topDown)
+{
+    int32_t signed_height = topDown ? -(int32_t)height : (int32_t)height;
+
+    std::memset(p, 0, HEADER_SIZE);
+    p[0] = 'B';
+    p[1] = 'M';
+    write_uint32(p + 0x02, fileSize(width, height));
+    write_uint32(p + 0x0A, HEADER_SIZE);
+    p += FILE_HEADER_SIZE;
+    write_uint32(p + 0x00, INFO_HEADER_SIZE + BIT_FIELD_SIZE);
+    write_uint32(p + 0x04, width);
+    write_uint32(p + 0x08, (uint32_t)signed_height);
+    write_uint16(p + 0x0C, 1);
+    write_uint16(p + 0x0E, 16);
+    write_uint32(p + 0x10, 3);
+    write_uint32(p + 0x14, imageSize(width, height));
+    p += INFO_HEADER_SIZE;
+    write_uint32(p + 0x00, 0x0000F800);
+    write_uint32(p + 0x04, 0x000007E0);
+    write_uint32(p + 0x08, 0x0000001F);
+}
+} // namespace detail
+
+/**
+ * Drawing functions shared by Bitmap and Image.
+ * Derived must provide width(), height() and row(y).
+ */
+template <class Derived>
+class Surface
+{
+public:
+    /** Draw a RGB565 color on a pixel. Out of range pixels are ignored. */
+    void setPixel(uint32_t x, uint32_t y, uint16_t col)
+    {
+        if (x < self().width() && y < self().height())
+            BMP_RGB565_put565(self().row(y), x, col);
+    }
+
+    /** Get a RGB565 color of a pixel. Out of range pixels return 0. */
+    uint16_t getPixel(uint32_t x, uint32_t y) const
+    {
+        if (x < self().width() && y < self().height())
+            return BMP_RGB565_get565(self().row(y), x);
+        return 0;
+    }
+
+    /** Draw a RGB565 color on a pixel. (No range check) */
+    void setPixelUnchecked(uint32_t x, uint32_t y, uint16_t col) { BMP_RGB565_put565(self().row(y), x, col); }
+
+    /** Get a RGB565 color of a pixel. (No range check) */
+    uint16_t getPixelUnchecked(uint32_t x, uint32_t y) const { return BMP_RGB565_get565(self().row(y), x); }
+
+    /** Fill the whole image. */
+    void fill(uint16_t col)
+    {
+        for (uint32_t y = 0; y < self().height(); y++)
+        {
+            uint16_t *row = self().row(y);
+            for (uint32_t x = 0; x < self().width(); x++)
+                BMP_RGB565_put565(row, x, col);
+        }
+    }
+
+    /** Draw a filled rectangle (inclusive corners). Same range rule as BMP_RGB565_drawRect565(). */
+    void drawRect(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, uint16_t col)
+    {
+        if (x0 >= self().width() || x1 >= self().width() || y0 >= self().height() || y1 >= self().height())
+            return;
+        if (x0 > x1)
+            std::swap(x0, x1);
+        if (y0 > y1)
+            std::swap(y0, y1);
+        for (uint32_t y = y0; y <= y1; y++)
+        {
+            uint16_t *row = self().row(y);
+            for (uint32_t x = x0; x <= x1; x++)
+                BMP_RGB565_put565(row, x, col);
+        }
+    }
+
+    /** Draw a straight line. See BMP_RGB565_drawLine565(). */
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t col)
+    {
+        BMP_RGB565_drawLine565(self().data(), x0, y0, x1, y1, col);
+    }
+
+    /** Draw text. See BMP_RGB565_drawText565(). */
+    void drawText(const char *text, const BMP_RGB565_font_st &font, uint32_t x, uint32_t y, uint16_t col)
+    {
+        BMP_RGB565_drawText565(self().data(), text, font, x, y, col);
+    }
+
+private:
+    Derived &self() { return static_cast<Derived &>(*this); }
+    const Derived &self() const { return static_cast<const Derived &>(*this); }
+};
+
+/**
+ * Fixed-size image.
+ * @tparam W       width  [pixel]
+ * @tparam H       height [pixel]
+ * @tparam TopDown true: rows are stored top to bottom (negative height in the header)
+ */
+template <uint32_t W, uint32_t H, bool TopDown = false>
+class Bitmap : public Surface<Bitmap<W, H, TopDown>>
+{
+    static_assert(W > 0 && H > 0, "Bitmap dimensions must not be zero");
+    static_assert(W <= 0x7FFFFFFF / 2 && (uint64_t)HEADER_SIZE + (uint64_t)bytesPerRow(W) * H <= 0xFFFFFFFFu,
+                  "Bitmap is too large for a BMP file");
+
+public:
+    static constexpr uint32_t WIDTH     = W;
+    static constexpr uint32_t HEIGHT    = H;
+    static constexpr bool     TOP_DOWN  = TopDown;
+    static constexpr uint32_t STRIDE    = bytesPerRow(W) / 2;   // [pixel]
+    static constexpr uint32_t FILE_SIZE = fileSize(W, H);       // [byte]
+
+    Bitmap()
+    {
+        detail::writeHeader(buf_.data(), W, H, TopDown);
+        std::memset(buf_.data() + HEADER_SIZE, 0, FILE_SIZE - HEADER_SIZE);
+    }
+
+    static constexpr uint32_t width() { return W; }
+    static constexpr uint32_t height() { return H; }
+    static constexpr uint32_t size() { return FILE_SIZE; }
+
+    /** Whole file (header + pixel data). Can be passed to BMP_RGB565_* functions. */
+    uint8_t *data() { return buf_.data(); }
+    const uint8_t *data() const { return buf_.data(); }
+
+    /** Pointer to the pixels of row y (row order resolved at compile time). */
+    uint16_t *row(uint32_t y) { return pixels() + STRIDE * (TopDown ? y : H - 1 - y); }
+    const uint16_t *row(uint32_t y) const { return pixels() + STRIDE * (TopDown ? y : H - 1 - y); }
+
+#ifdef BMP_RGB565_HAS_SPAN
+    std::span<uint16_t, W> rowSpan(uint32_t y) { return std::span<uint16_t, W>(row(y), W); }
+    std::span<const uint16_t, W> rowSpan(uint32_t y) const { return std::span<const uint16_t, W>(row(y), W); }
+#endif
+
+private:
+    uint16_t *pixels() { return reinterpret_cast<uint16_t *>(buf_.data() + HEADER_SIZE); }
+    const uint16_t *pixels() const { return reinterpret_cast<const uint16_t *>(buf_.data() + HEADER_SIZE); }
+
+    // HEADER_SIZE is even, so pixels are 2-byte aligned
+    alignas(4) std::array<uint8_t, FILE_SIZE> buf_;
+};
+
+/**
+ * Runtime-size image owning a buffer from BMP_RGB565_create(). Move-only.
+ */
+class Image : public Surface<Image>
+{
+public:
+    Image() = default;
+
+    /** Create an image. Check with operator bool (false when allocation failed). */
+    Image(uint32_t width, uint32_t height) : pbmp_(BMP_RGB565_create(width, height)) { cache(); }
+
+    /**
+     * Take ownership of an image created by the C library.
+     * Indexed images have no RGB565 rows: they are freed and operator bool is false.
+     */
+    explicit Image(uint8_t *pbmp) : pbmp_(accept(pbmp)) { cache(); }
+
+    Image(const Image &) = delete;
+    Image &operator=(const Image &) = delete;
+
+    Image(Image &&other) noexcept
+        : pbmp_(other.pbmp_), width_(other.width_), height_(other.height_)
+    {
+        other.pbmp_ = nullptr;
+        other.cache();
+    }
+
+    Image &operator=(Image &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset(other.release());
+        }
+        return *this;
+    }
+
+    ~Image() { reset(); }
+
+    explicit operator bool() const { return pbmp_ != nullptr; }
+
+    uint32_t width() const { return width_; }
+    uint32_t height() const { return height_; }
+    uint32_t size() const { return pbmp_ ? BMP_RGB565_getFileSize(pbmp_) : 0; }
+
+    /** Whole file (header + pixel data). Can be passed to BMP_RGB565_* functions. */
+    uint8_t *data() { return pbmp_; }
+    const uint8_t *data() const { return pbmp_; }
+
+    /** Pointer to the pixels of row y (Range:[0,height-1]). NULL when the image is empty or y is out of range. */
+    uint16_t *row(uint32_t y) { return BMP_RGB565_getRow(pbmp_, y); }
+    const uint16_t *row(uint32_t y) const { return BMP_RGB565_getRow(pbmp_, y); }
+
+#ifdef BMP_RGB565_HAS_SPAN
+    std::span<uint16_t> rowSpan(uint32_t y) { return std::span<uint16_t>(row(y), width_); }
+    std::span<const uint16_t> rowSpan(uint32_t y) const { return std::span<const uint16_t>(row(y), width_); }
+#endif
+
+    /** Give up ownership. The caller must free the image with BMP_RGB565_free(). */
+    uint8_t *release()
+    {
+        uint8_t *pbmp = pbmp_;
+        pbmp_ = nullptr;
+        cache();
+        return pbmp;
+    }
+
+    /** Free the current image and take ownership of pbmp. Indexed images are freed and rejected. */
+    void reset(uint8_t *pbmp = nullptr)
+    {
+        if (pbmp_ != nullptr)
+            BMP_RGB565_free(pbmp_);
+        pbmp_ = accept(pbmp);
+        cache();
+    }
+
+private:
+    // Only 16bpp images have RGB565 rows (BMP_RGB565_getRow() is NULL for indexed images)
+    static uint8_t *accept(uint8_t *pbmp)
+    {
+        if (pbmp != nullptr && BMP_RGB565_getBitCount(pbmp) != 16)
+        {
+            BMP_RGB565_free(pbmp);
+            return nullptr;
+        }
+        return pbmp;
+    }
+
+    void cache()
+    {
+        width_  = pbmp_ ? BMP_RGB565_getWidth(pbmp_) : 0;
+        height_ = pbmp_ ? BMP_RGB565_getHeight(pbmp_) : 0;
+    }
+
+    uint8_t *pbmp_ = nullptr;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+};
+
+} // namespace bmp565
+
+#endif /* _BMP_RGB565_HPP_ */
+
+/***************************************************************END OF FILE****/
@@ -0,0 +1,830 @@
+/* Feature test macro (pread, mmap) ------------------------------------------*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+/* Include system header files -----------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+/* Include user header files -------------------------------------------------*/
+#include "bmp_rgb565_rec.h"
+
+/* Imported variables --------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/*
+ * File layout (little-endian)
+ *   File header (BMP_RGB565_REC_HEADER_SIZE bytes)
+ *     0x00 "R565REC1"
+ *     0x08 version (uint32_t), width (uint32_t), height (uint32_t), keyframe interval (uint32_t)
+ *     0x18 image size [byte] (uint32_t), reserved (uint32_t)
+ *     0x20 shared BMP header (70 bytes, same as BMP_RGB565_create())
+ *   Frame records (8-byte aligned)
+ *     0x00 "FRM0", encoding (uint32_t), timestamp (uint64_t), payload size (uint32_t), reserved (uint32_t)
+ *     0x18 payload: raw pixel data (bottom-up rows, as in a BMP file) or delta
+ *   Index (written by BMP_RGB565_recClose(). Rebuilt from the records when missing)
+ *     offset (uint64_t), timestamp (uint64_t) x number of frames
+ *   Footer
+ *     "R565IDX1", index offset (uint64_t), number of frames (uint32_t), reserved (uint32_t)
+ *
+ * Delta payload: pixels XORed with the previous frame, as a sequence of
+ *   skip (uint16_t) : number of unchanged pixels
+ *   count (uint16_t): number of following XOR words
+ *   XOR words (uint16_t x count)
+ */
+#define BMP_RGB565_REC_HEADER_SIZE      128
+#define BMP_RGB565_REC_BMP_HEADER       0x20
+#define BMP_RGB565_REC_BMP_HEADER_SIZE  70
+#define BMP_RGB565_REC_RECORD_SIZE      24
+#define BMP_RGB565_REC_INDEX_ENTRY_SIZE 16
+#define BMP_RGB565_REC_FOOTER_SIZE      24
+#define BMP_RGB565_REC_ALIGN            8
+
+#define BMP_RGB565_REC_ENCODING_RAW     0
+#define BMP_RGB565_REC_ENCODING_DELTA   1
+
+/* Private types -------------------------------------------------------------*/
+/* Private enum tag ----------------------------------------------------------*/
+/* Private struct/union tag --------------------------------------------------*/
+typedef struct
+{
+    uint64_t offset;
+    uint64_t timestamp;
+} BMP_RGB565_recIndex_st;
+
+struct BMP_RGB565_recWriter
+{
+    int fd;
+    uint32_t width;
+    uint32_t height;
+    uint32_t image_size;
+    uint32_t keyframe_interval;
+    uint32_t frames_since_key;
+    uint64_t file_end;
+    uint8_t *prev;              // image holding the previous frame (and the shared header)
+    uint8_t *scratch;           // bottom-up copy of a top-down frame
+    uint8_t *delta;             // delta payload buffer
+    BMP_RGB565_recIndex_st *index;
+    uint32_t count;
+    uint32_t capacity;
+};
+
+struct BMP_RGB565_recReader
+{
+    const uint8_t *map;
+    size_t map_size;
+    uint32_t width;
+    uint32_t height;
+    uint32_t image_size;
+    BMP_RGB565_recIndex_st *index;
+    uint32_t count;
+    uint8_t *decoded;           // pixel data of the last decoded frame
+    int64_t decoded_frame;      // -1: none
+};
+
+/* Private variables ---------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+BMP_RGB565_recWriter_t *BMP_RGB565_recCreate(const char *, uint32_t, uint32_t, uint32_t);
+int       BMP_RGB565_recAppend       (BMP_RGB565_recWriter_t *, uint8_t *, uint64_t);
+int       BMP_RGB565_recClose        (BMP_RGB565_recWriter_t *);
+BMP_RGB565_recReader_t *BMP_RGB565_recOpen(const char *);
+void      BMP_RGB565_recFree         (BMP_RGB565_recReader_t *);
+uint32_t  BMP_RGB565_recGetWidth     (BMP_RGB565_recReader_t *);
+uint32_t  BMP_RGB565_recGetHeight    (BMP_RGB565_recReader_t *);
+uint32_t  BMP_RGB565_recGetFrameCount(BMP_RGB565_recReader_t *);
+uint64_t  BMP_RGB565_recGetTimestamp (BMP_RGB565_recReader_t *, uint32_t);
+int32_t   BMP_RGB565_recFindFrame    (BMP_RGB565_recReader_t *, uint64_t);
+const uint8_t  *BMP_RGB565_recGetHeader(BMP_RGB565_recReader_t *);
+const uint16_t *BMP_RGB565_recGetPixels(BMP_RGB565_recReader_t *, uint32_t);
+const uint16_t *BMP_RGB565_recGetRow (BMP_RGB565_recReader_t *, uint32_t, uint32_t);
+int       BMP_RGB565_recReadView     (BMP_RGB565_recReader_t *, uint32_t, uint32_t, uint32_t, const BMP_RGB565_view_st *);
+int       BMP_RGB565_recReadFrame    (BMP_RGB565_recReader_t *, uint32_t, uint8_t *);
+int       BMP_RGB565_recExportFrame  (BMP_RGB565_recReader_t *, uint32_t, const char *);
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t BMP_RGB565_recEncodeDelta(const uint8_t *, const uint8_t *, uint32_t, uint8_t *, uint32_t);
+static int BMP_RGB565_recApplyDelta(uint8_t *, uint32_t, const uint8_t *, uint32_t);
+static const uint8_t *BMP_RGB565_recDecode(BMP_RGB565_recReader_t *, uint32_t);
+static uint64_t BMP_RGB565_recCheckRecord(BMP_RGB565_recReader_t *, uint64_t, uint64_t);
+static int BMP_RGB565_recWriteAll(int, const void *, size_t);
+static uint16_t BMP_RGB565_recRead16(const uint8_t *);
+static uint32_t BMP_RGB565_recRead32(const uint8_t *);
+static uint64_t BMP_RGB565_recRead64(const uint8_t *);
+static void BMP_RGB565_recWrite16(uint16_t, uint8_t *);
+static void BMP_RGB565_recWrite32(uint32_t, uint8_t *);
+static void BMP_RGB565_recWrite64(uint64_t, uint8_t *);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Create a recording file.
+  * @param  path              file path
+  * @param  width             width of frames [pixel]
+  * @param  height            height of frames [pixel]
+  * @param  keyframe_interval 0 or 1: every frame is stored raw (zero-copy readable).
+  *                           n > 1: every n-th frame is raw, the others are stored as a delta
+  *                           of the previous frame when it is smaller.
+  * @retval pointer to a writer. When error, return NULL
+  */
+BMP_RGB565_recWriter_t *BMP_RGB565_recCreate(const char *path, uint32_t width, uint32_t height, uint32_t keyframe_interval)
+{
+    uint8_t header[BMP_RGB565_REC_HEADER_SIZE];
+
+    if (path == NULL || width == 0 || height == 0)
+        return NULL;
+
+    BMP_RGB565_recWriter_t *rec = (BMP_RGB565_recWriter_t *)calloc(1, sizeof(BMP_RGB565_recWriter_t));
+    if (rec == NULL)
+        return NULL;
+
+    rec->fd = -1;
+    rec->width = width;
+    rec->height = height;
+    rec->keyframe_interval = keyframe_interval;
+    rec->prev = BMP_RGB565_create(width, height);
+    if (rec->prev == NULL)
+        goto error;
+    rec->image_size = BMP_RGB565_getImageSize(rec->prev);
+    rec->scratch = (uint8_t *)malloc(rec->image_size);
+    rec->delta = (uint8_t *)malloc(rec->image_size);
+    if (rec->scratch == NULL || rec->delta == NULL)
+        goto error;
+
+    rec->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (rec->fd < 0)
+        goto error;
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, "R565REC1", 8);
+    BMP_RGB565_recWrite32(1,                 header + 0x08);
+    BMP_RGB565_recWrite32(width,             header + 0x0C);
+    BMP_RGB565_recWrite32(height,            header + 0x10);
+    BMP_RGB565_recWrite32(keyframe_interval, header + 0x14);
+    BMP_RGB565_recWrite32(rec->image_size,   header + 0x18);
+    memcpy(header + BMP_RGB565_REC_BMP_HEADER, rec->prev, BMP_RGB565_REC_BMP_HEADER_SIZE);
+    if (BMP_RGB565_recWriteAll(rec->fd, header, sizeof(header)) != 0)
+        goto error;
+    rec->file_end = sizeof(header);
+    return rec;
+
+error:
+    if (rec->fd >= 0)
+        close(rec->fd);
+    BMP_RGB565_free(rec->prev);
+    free(rec->scratch);
+    free(rec->delta);
+    free(rec);
+    return NULL;
+}
+
+/**
+  * @brief  Append a frame to a recording.
+  * @param  rec       pointer to a writer
+  * @param  pbmp      pointer to a image of the recording size
+  * @param  timestamp timestamp of the frame (any unit, should not decrease)
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_recAppend(BMP_RGB565_recWriter_t *rec, uint8_t *pbmp, uint64_t timestamp)
+{
+    uint8_t record[BMP_RGB565_REC_RECORD_SIZE];
+    static const uint8_t padding[BMP_RGB565_REC_ALIGN] = {0};
+
+    if (rec == NULL || pbmp == NULL)
+        return -1;
+    if (BMP_RGB565_getBitCount(pbmp) != 16 || BMP_RGB565_getWidth(pbmp) != rec->width || BMP_RGB565_getHeight(pbmp) != rec->height)
+        return -1;
+
+    if (rec->count == rec->capacity)
+    {
+        uint32_t capacity = rec->capacity ? rec->capacity * 2 : 256;
+        BMP_RGB565_recIndex_st *index = (BMP_RGB565_recIndex_st *)realloc(rec->index, capacity * sizeof(BMP_RGB565_recIndex_st));
+        if (index == NULL)
+            return -1;
+        rec->index = index;
+        rec->capacity = capacity;
+    }
+
+    // Pixel data in file order (bottom-up rows)
+    uint32_t bytes_per_row = rec->image_size / rec->height;
+    const uint8_t *pixels = pbmp + BMP_RGB565_getOffset(pbmp);
+    if ((const uint8_t *)BMP_RGB565_getRow(pbmp, 0) != pixels + (size_t)bytes_per_row * (rec->height - 1))
+    {
+        for (uint32_t y = 0; y < rec->height; y++)
+            memcpy(rec->scratch + (size_t)bytes_per_row * (rec->height - 1 - y), BMP_RGB565_getRow(pbmp, y), bytes_per_row);
+        pixels = rec->scratch;
+    }
+
+    uint8_t *prev_pixels = rec->prev + BMP_RGB565_getOffset(rec->prev);
+    uint32_t encoding = BMP_RGB565_REC_ENCODING_RAW;
+    const uint8_t *payload = pixels;
+    uint32_t payload_size = rec->image_size;
+
+    if (rec->keyframe_interval > 1 && rec->count > 0 && rec->frames_since_key + 1 < rec->keyframe_interval)
+    {
+        uint32_t size = BMP_RGB565_recEncodeDelta(pixels, prev_pixels, rec->image_size, rec->delta, rec->image_size - 1);
+        if (size > 0)
+        {
+            encoding = BMP_RGB565_REC_ENCODING_DELTA;
+            payload = rec->delta;
+            payload_size = size;
+        }
+    }
+
+    memcpy(record, "FRM0", 4);
+    BMP_RGB565_recWrite32(encoding,     record + 0x04);
+    BMP_RGB565_recWrite64(timestamp,    record + 0x08);
+    BMP_RGB565_recWrite32(payload_size, record + 0x10);
+    BMP_RGB565_recWrite32(0,            record + 0x14);
+    uint32_t pad = (BMP_RGB565_REC_ALIGN - payload_size % BMP_RGB565_REC_ALIGN) % BMP_RGB565_REC_ALIGN;
+
+    if (BMP_RGB565_recWriteAll(rec->fd, record, sizeof(record)) != 0
+     || BMP_RGB565_recWriteAll(rec->fd, payload, payload_size) != 0
+     || BMP_RGB565_recWriteAll(rec->fd, padding, pad) != 0)
+        return -1;
+
+    rec->index[rec->count].offset = rec->file_end;
+    rec->index[rec->count].timestamp = timestamp;
+    rec->count++;
+    rec->file_end += sizeof(record) + payload_size + pad;
+    rec->frames_since_key = (encoding == BMP_RGB565_REC_ENCODING_RAW) ? 0 : rec->frames_since_key + 1;
+    memcpy(prev_pixels, pixels, rec->image_size);
+    return 0;
+}
+
+/**
+  * @brief  Write the index and close a recording.
+  * @param  rec pointer to a writer (freed by this function)
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_recClose(BMP_RGB565_recWriter_t *rec)
+{
+    uint8_t footer[BMP_RGB565_REC_FOOTER_SIZE];
+    int status = 0;
+
+    if (rec == NULL)
+        return -1;
+
+    size_t index_size = (size_t)rec->count * BMP_RGB565_REC_INDEX_ENTRY_SIZE;
+    uint8_t *index = (uint8_t *)malloc(index_size + 1);
+    if (index == NULL)
+        status = -1;
+    else
+    {
+        for (uint32_t i = 0; i < rec->count; i++)
+        {
+            BMP_RGB565_recWrite64(rec->index[i].offset,    index + i * BMP_RGB565_REC_INDEX_ENTRY_SIZE);
+            BMP_RGB565_recWrite64(rec->index[i].timestamp, index + i * BMP_RGB565_REC_INDEX_ENTRY_SIZE + 8);
+        }
+        memcpy(footer, "R565IDX1", 8);
+        BMP_RGB565_recWrite64(rec->file_end, footer + 0x08);
+        BMP_RGB565_recWrite32(rec->count,    footer + 0x10);
+        BMP_RGB565_recWrite32(0,             footer + 0x14);
+        if (BMP_RGB565_recWriteAll(rec->fd, index, index_size) != 0
+         || BMP_RGB565_recWriteAll(rec->fd, footer, sizeof(footer)) != 0)
+            status = -1;
+        free(index);
+    }
+
+    if (close(rec->fd) != 0)
+        status = -1;
+    BMP_RGB565_free(rec->prev);
+    free(rec->scratch);
+    free(rec->delta);
+    free(rec->index);
+    free(rec);
+    return status;
+}
+
+/**
+  * @brief  Open a recording for reading.
+  * @param  path file path
+  * @retval pointer to a reader. When error, return NULL
+  * @detail A recording which was not closed (e.g. after a crash) is recovered by
+  *         scanning its frame records.
+  */
+BMP_RGB565_recReader_t *BMP_RGB565_recOpen(const char *path)
+{
+    struct stat st;
+
+    if (path == NULL)
+        return NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < BMP_RGB565_REC_HEADER_SIZE)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    BMP_RGB565_recReader_t *rec = (BMP_RGB565_recReader_t *)calloc(1, sizeof(BMP_RGB565_recReader_t));
+    if (rec == NULL)
+    {
+        munmap(map, size);
+        return NULL;
+    }
+    rec->map = (const uint8_t *)map;
+    rec->map_size = size;
+    rec->decoded_frame = -1;
+
+    const uint8_t *p = rec->map;
+    rec->width = BMP_RGB565_recRead32(p + 0x0C);
+    rec->height = BMP_RGB565_recRead32(p + 0x10);
+    rec->image_size = BMP_RGB565_recRead32(p + 0x18);
+    if (memcmp(p, "R565REC1", 8) != 0 || BMP_RGB565_recRead32(p + 0x08) != 1 || rec->width == 0 || rec->height == 0
+     || (uint64_t)rec->image_size != ((((uint64_t)rec->width << 1) + 3) & ~(uint64_t)3) * rec->height)
+        goto error;
+
+    rec->decoded = (uint8_t *)malloc(rec->image_size);
+    if (rec->decoded == NULL)
+        goto error;
+
+    // Index from the footer
+    const uint8_t *footer = p + size - BMP_RGB565_REC_FOOTER_SIZE;
+    if (size >= BMP_RGB565_REC_HEADER_SIZE + BMP_RGB565_REC_FOOTER_SIZE && memcmp(footer, "R565IDX1", 8) == 0)
+    {
+        uint64_t index_offset = BMP_RGB565_recRead64(footer + 0x08);
+        uint32_t count = BMP_RGB565_recRead32(footer + 0x10);
+        if (index_offset >= BMP_RGB565_REC_HEADER_SIZE && index_offset <= size - BMP_RGB565_REC_FOOTER_SIZE
+         && (uint64_t)count * BMP_RGB565_REC_INDEX_ENTRY_SIZE == size - BMP_RGB565_REC_FOOTER_SIZE - index_offset)
+        {
+            rec->index = (BMP_RGB565_recIndex_st *)malloc(((size_t)count + 1) * sizeof(BMP_RGB565_recIndex_st));
+            if (rec->index == NULL)
+                goto error;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const uint8_t *entry = p + index_offset + (size_t)i * BMP_RGB565_REC_INDEX_ENTRY_SIZE;
+                rec->index[i].offset = BMP_RGB565_recRead64(entry);
+                rec->index[i].timestamp = BMP_RGB565_recRead64(entry + 8);
+                if (BMP_RGB565_recCheckRecord(rec, rec->index[i].offset, index_offset) == 0)
+                {
+                    // Corrupt index: fall back to scanning
+                    free(rec->index);
+                    rec->index = NULL;
+                    break;
+                }
+            }
+            if (rec->index != NULL)
+                rec->count = count;
+        }
+    }
+
+    // No valid index: scan the records
+    if (rec->index == NULL)
+    {
+        uint32_t capacity = 0;
+        uint64_t offset = BMP_RGB565_REC_HEADER_SIZE;
+        uint64_t end;
+        while ((end = BMP_RGB565_recCheckRecord(rec, offset, size)) != 0)
+        {
+            if (rec->count == capacity)
+            {
+                capacity = capacity ? capacity * 2 : 256;
+                BMP_RGB565_recIndex_st *index = (BMP_RGB565_recIndex_st *)realloc(rec->index, capacity * sizeof(BMP_RGB565_recIndex_st));
+                if (index == NULL)
+                    goto error;
+                rec->index = index;
+            }
+            rec->index[rec->count].offset = offset;
+            rec->index[rec->count].timestamp = BMP_RGB565_recRead64(p + offset + 0x08);
+            rec->count++;
+            offset = (end + BMP_RGB565_REC_ALIGN - 1) & ~(uint64_t)(BMP_RGB565_REC_ALIGN - 1);
+        }
+    }
+    return rec;
+
+error:
+    BMP_RGB565_recFree(rec);
+    return NULL;
+}
+
+/**
+  * @brief  Close a recording opened by BMP_RGB565_recOpen().
+  * @param  rec pointer to a reader
+  * @retval None
+  * @detail Pointers returned by the reader become invalid.
+  */
+void BMP_RGB565_recFree(BMP_RGB565_recReader_t *rec)
+{
+    if (rec == NULL)
+        return;
+
+    munmap((void *)rec->map, rec->map_size);
+    free(rec->index);
+    free(rec->decoded);
+    free(rec);
+}
+
+/**
+  * @brief  Get width of frames of a recording.
+  * @param  rec pointer to a reader
+  * @retval width [pixel]
+  */
+uint32_t BMP_RGB565_recGetWidth(BMP_RGB565_recReader_t *rec)
+{
+    return (rec == NULL) ? 0 : rec->width;
+}
+
+/**
+  * @brief  Get height of frames of a recording.
+  * @param  rec pointer to a reader
+  * @retval height [pixel]
+  */
+uint32_t BMP_RGB565_recGetHeight(BMP_RGB565_recReader_t *rec)
+{
+    return (rec == NULL) ? 0 : rec->height;
+}
+
+/**
+  * @brief  Get number of frames of a recording.
+  * @param  rec pointer to a reader
+  * @retval number of frames
+  */
+uint32_t BMP_RGB565_recGetFrameCount(BMP_RGB565_recReader_t *rec)
+{
+    return (rec == NULL) ? 0 : rec->count;
+}
+
+/**
+  * @brief  Get timestamp of a frame.
+  * @param  rec   pointer to a reader
+  * @param  frame frame number (Range:[0,count-1])
+  * @retval timestamp. When out of range, return 0
+  */
+uint64_t BMP_RGB565_recGetTimestamp(BMP_RGB565_recReader_t *rec, uint32_t frame)
+{
+    if (rec == NULL || frame >= rec->count)
+        return 0;
+    return rec->index[frame].timestamp;
+}
+
+/**
+  * @brief  Find the last frame whose timestamp is not after a given time.
+  * @param  rec       pointer to a reader
+  * @param  timestamp timestamp
+  * @retval frame number. When no frame is found, return -1
+  * @detail Binary search. Timestamps must not decrease.
+  */
+int32_t BMP_RGB565_recFindFrame(BMP_RGB565_recReader_t *rec, uint64_t timestamp)
+{
+    if (rec == NULL || rec->count == 0 || rec->index[0].timestamp > timestamp)
+        return -1;
+
+    uint32_t lo = 0, hi = rec->count;     // index[lo].timestamp <= timestamp < index[hi].timestamp
+    while (hi - lo > 1)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (rec->index[mid].timestamp <= timestamp)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return (int32_t)lo;
+}
+
+/**
+  * @brief  Get the shared BMP header of a recording.
+  * @param  rec pointer to a reader
+  * @retval pointer to the 70-byte BMP header. When error, return NULL
+  */
+const uint8_t *BMP_RGB565_recGetHeader(BMP_RGB565_recReader_t *rec)
+{
+    return (rec == NULL) ? NULL : rec->map + BMP_RGB565_REC_BMP_HEADER;
+}
+
+/**
+  * @brief  Get the pixel data of a raw frame without copying.
+  * @param  rec   pointer to a reader
+  * @param  frame frame number (Range:[0,count-1])
+  * @retval pointer to the pixel data in the mapped file (bottom-up rows, as in a BMP file).
+  *         When the frame is delta encoded or out of range, return NULL
+  */
+const uint16_t *BMP_RGB565_recGetPixels(BMP_RGB565_recReader_t *rec, uint32_t frame)
+{
+    if (rec == NULL || frame >= rec->count)
+        return NULL;
+
+    const uint8_t *record = rec->map + rec->index[frame].offset;
+    if (BMP_RGB565_recRead32(record + 0x04) != BMP_RGB565_REC_ENCODING_RAW)
+        return NULL;
+    return (const uint16_t *)(record + BMP_RGB565_REC_RECORD_SIZE);
+}
+
+/**
+  * @brief  Get a pointer to the pixels of a row of a frame.
+  * @param  rec   pointer to a reader
+  * @param  frame frame number (Range:[0,count-1])
+  * @param  y     y of a image(Range:[0,height-1]) [pixel]
+  * @retval pointer to the first pixel of row y. When error, return NULL
+  * @detail Raw frames are returned from the mapped file. Delta frames are decoded into
+  *         an internal buffer which is valid until another delta frame is accessed.
+  */
+const uint16_t *BMP_RGB565_recGetRow(BMP_RGB565_recReader_t *rec, uint32_t frame, uint32_t y)
+{
+    if (rec == NULL || y >= rec->height)
+        return NULL;
+
+    const uint8_t *pixels = BMP_RGB565_recDecode(rec, frame);
+    if (pixels == NULL)
+        return NULL;
+
+    uint32_t bytes_per_row = rec->image_size / rec->height;
+    return (const uint16_t *)(pixels + (size_t)bytes_per_row * (rec->height - 1 - y));
+}
+
+/**
+  * @brief  Read a region of a frame into a view.
+  * @param  rec   pointer to a reader
+  * @param  frame frame number (Range:[0,count-1])
+  * @param  x     x of the region in the frame (Range:[0,width-1] ) [pixel]
+  * @param  y     y of the region in the frame (Range:[0,height-1]) [pixel]
+  * @param  dst   pointer to a destination view (its size is the size of the region)
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail The region is clipped to the frame. Pixels of the view outside the frame are left unchanged.
+  *         Use BMP_RGB565_recGetRow() to read rows without copying.
+  */
+int BMP_RGB565_recReadView(BMP_RGB565_recReader_t *rec, uint32_t frame, uint32_t x, uint32_t y, const BMP_RGB565_view_st *dst)
+{
+    if (rec == NULL || dst == NULL || x >= rec->width || y >= rec->height)
+        return -1;
+
+    const uint8_t *pixels = BMP_RGB565_recDecode(rec, frame);
+    if (pixels == NULL)
+        return -1;
+
+    uint32_t width  = (dst->width  < rec->width  - x) ? dst->width  : rec->width  - x;
+    uint32_t height = (dst->height < rec->height - y) ? dst->height : rec->height - y;
+    uint32_t bytes_per_row = rec->image_size / rec->height;
+    for (uint32_t j = 0; j < height; j++)
+    {
+        const uint8_t *src = pixels + (size_t)bytes_per_row * (rec->height - 1 - (y + j)) + ((size_t)x << 1);
+        memcpy(BMP_RGB565_viewGetRow(dst, j), src, (size_t)width << 1);
+    }
+    return 0;
+}
+
+/**
+  * @brief  Read a frame into an image.
+  * @param  rec     pointer to a reader
+  * @param  frame   frame number (Range:[0,count-1])
+  * @param  pbmpDst pointer to a image of the recording size
+  * @retval status (0: Success, otherwise: Failure)
+  */
+int BMP_RGB565_recReadFrame(BMP_RGB565_recReader_t *rec, uint32_t frame, uint8_t *pbmpDst)
+{
+    if (rec == NULL || pbmpDst == NULL)
+        return -1;
+    if (BMP_RGB565_getBitCount(pbmpDst) != 16 || BMP_RGB565_getWidth(pbmpDst) != rec->width || BMP_RGB565_getHeight(pbmpDst) != rec->height)
+        return -1;
+
+    const uint8_t *pixels = BMP_RGB565_recDecode(rec, frame);
+    if (pixels == NULL)
+        return -1;
+
+    uint32_t bytes_per_row = rec->image_size / rec->height;
+    for (uint32_t y = 0; y < rec->height; y++)
+        memcpy(BMP_RGB565_getRow(pbmpDst, y), pixels + (size_t)bytes_per_row * (rec->height - 1 - y), bytes_per_row);
+    return 0;
+}
+
+/**
+  * @brief  Export a frame as a standard BMP file.
+  * @param  rec   pointer to a reader
+  * @param  frame frame number (Range:[0,count-1])
+  * @param  path  file path
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail The shared header and the pixel data are written with a single writev().
+  */
+int BMP_RGB565_recExportFrame(BMP_RGB565_recReader_t *rec, uint32_t frame, const char *path)
+{
+    if (rec == NULL || path == NULL)
+        return -1;
+
+    const uint8_t *pixels = BMP_RGB565_recDecode(rec, frame);
+    if (pixels == NULL)
+        return -1;
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+
+    struct iovec iov[2];
+    iov[0].iov_base = (void *)(rec->map + BMP_RGB565_REC_BMP_HEADER);
+    iov[0].iov_len  = BMP_RGB565_REC_BMP_HEADER_SIZE;
+    iov[1].iov_base = (void *)pixels;
+    iov[1].iov_len  = rec->image_size;
+
+    size_t total = BMP_RGB565_REC_BMP_HEADER_SIZE + (size_t)rec->image_size;
+    ssize_t written;
+    do
+    {
+        written = writev(fd, iov, 2);
+    } while (written < 0 && errno == EINTR);
+
+    // Short write: fall back to writing the rest piece by piece
+    int status = 0;
+    if (written < 0)
+        status = -1;
+    else if ((size_t)written < total)
+    {
+        size_t done = (size_t)written;
+        if (done < BMP_RGB565_REC_BMP_HEADER_SIZE)
+            status = BMP_RGB565_recWriteAll(fd, (const uint8_t *)iov[0].iov_base + done, BMP_RGB565_REC_BMP_HEADER_SIZE - done);
+        done = (done > BMP_RGB565_REC_BMP_HEADER_SIZE) ? done - BMP_RGB565_REC_BMP_HEADER_SIZE : 0;
+        if (status == 0)
+            status = BMP_RGB565_recWriteAll(fd, pixels + done, rec->image_size - done);
+    }
+    if (close(fd) != 0)
+        status = -1;
+    return status;
+}
+
+
+/* Private functions ---------------------------------------------------------*/
+// Encode pixels as a delta of the previous frame.
+// Returns the payload size, or 0 when it would be larger than max_size.
+static uint32_t BMP_RGB565_recEncodeDelta(const uint8_t *cur, const uint8_t *prev, uint32_t size, uint8_t *pDst, uint32_t max_size)
+{
+    const uint32_t words = size / 2;
+    uint32_t i = 0, out = 0;
+
+    while (i < words)
+    {
+        uint32_t skip = 0, count = 0;
+        while (i < words && skip < 0xFFFF && memcmp(cur + i * 2, prev + i * 2, 2) == 0)
+        {
+            i++;
+            skip++;
+        }
+        uint32_t start = i;
+        while (i < words && count < 0xFFFF && memcmp(cur + i * 2, prev + i * 2, 2) != 0)
+        {
+            i++;
+            count++;
+        }
+        if (out + 4 + count * 2 > max_size)
+            return 0;
+
+        BMP_RGB565_recWrite16((uint16_t)skip, pDst + out);
+        BMP_RGB565_recWrite16((uint16_t)count, pDst + out + 2);
+        out += 4;
+        for (uint32_t k = start; k < start + count; k++, out += 2)
+        {
+            pDst[out]     = cur[k * 2]     ^ prev[k * 2];
+            pDst[out + 1] = cur[k * 2 + 1] ^ prev[k * 2 + 1];
+        }
+    }
+    return out;
+}
+
+// Apply a delta payload to the pixels of the previous frame.
+static int BMP_RGB565_recApplyDelta(uint8_t *pixels, uint32_t size, const uint8_t *pSrc, uint32_t src_size)
+{
+    const uint32_t words = size / 2;
+    uint32_t i = 0, in = 0;
+
+    while (in + 4 <= src_size)
+    {
+        uint32_t skip = BMP_RGB565_recRead16(pSrc + in);
+        uint32_t count = BMP_RGB565_recRead16(pSrc + in + 2);
+        in += 4;
+        i += skip;
+        if (i + count > words || in + count * 2 > src_size)
+            return -1;
+        for (uint32_t k = 0; k < count; k++, i++, in += 2)
+        {
+            pixels[i * 2]     ^= pSrc[in];
+            pixels[i * 2 + 1] ^= pSrc[in + 1];
+        }
+    }
+    return (in == src_size) ? 0 : -1;
+}
+
+// Get the pixel data of a frame: raw frames from the map, delta frames decoded
+// from the nearest raw frame (or from the last decoded frame when playing forward).
+static const uint8_t *BMP_RGB565_recDecode(BMP_RGB565_recReader_t *rec, uint32_t frame)
+{
+    if (frame >= rec->count)
+        return NULL;
+
+    const uint8_t *record = rec->map + rec->index[frame].offset;
+    if (BMP_RGB565_recRead32(record + 0x04) == BMP_RGB565_REC_ENCODING_RAW)
+        return (BMP_RGB565_recRead32(record + 0x10) == rec->image_size) ? record + BMP_RGB565_REC_RECORD_SIZE : NULL;
+    if (rec->decoded_frame == (int64_t)frame)
+        return rec->decoded;
+
+    // Start from the nearest raw frame, or continue from the decoded frame
+    uint32_t start = frame;
+    for (;;)
+    {
+        const uint8_t *key = rec->map + rec->index[start].offset;
+        if (BMP_RGB565_recRead32(key + 0x04) == BMP_RGB565_REC_ENCODING_RAW)
+        {
+            if (BMP_RGB565_recRead32(key + 0x10) != rec->image_size)
+                return NULL;
+            memcpy(rec->decoded, key + BMP_RGB565_REC_RECORD_SIZE, rec->image_size);
+            start++;
+            break;
+        }
+        if (start == 0)
+            return NULL;
+        if (rec->decoded_frame == (int64_t)start - 1)
+            break;
+        start--;
+    }
+
+    rec->decoded_frame = -1;
+    for (uint32_t i = start; i <= frame; i++)
+    {
+        const uint8_t *r = rec->map + rec->index[i].offset;
+        if (BMP_RGB565_recApplyDelta(rec->decoded, rec->image_size, r + BMP_RGB565_REC_RECORD_SIZE, BMP_RGB565_recRead32(r + 0x10)) != 0)
+            return NULL;
+    }
+    rec->decoded_frame = frame;
+    return rec->decoded;
+}
+
+// Check a frame record at offset: magic, encoding and payload size, and that it ends by limit.
+// Returns the end of the payload, or 0 when the record is invalid or truncated.
+static uint64_t BMP_RGB565_recCheckRecord(BMP_RGB565_recReader_t *rec, uint64_t offset, uint64_t limit)
+{
+    if (offset < BMP_RGB565_REC_HEADER_SIZE || offset > limit || limit - offset < BMP_RGB565_REC_RECORD_SIZE)
+        return 0;
+
+    const uint8_t *record = rec->map + offset;
+    uint32_t encoding = BMP_RGB565_recRead32(record + 0x04);
+    uint32_t payload_size = BMP_RGB565_recRead32(record + 0x10);
+    uint64_t end = offset + BMP_RGB565_REC_RECORD_SIZE + payload_size;
+    if (memcmp(record, "FRM0", 4) != 0 || payload_size > rec->image_size || end > limit)
+        return 0;
+    if (encoding == BMP_RGB565_REC_ENCODING_RAW ? payload_size != rec->image_size : encoding != BMP_RGB565_REC_ENCODING_DELTA)
+        return 0;
+    return end;
+}
+
+static int BMP_RGB565_recWriteAll(int fd, const void *pSrc, size_t size)
+{
+    const uint8_t *p = (const uint8_t *)pSrc;
+
+    while (size > 0)
+    {
+        ssize_t written = write(fd, p, size);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return -1;
+        p    += written;
+        size -= (size_t)written;
+    }
+    return 0;
+}
+
+static uint16_t BMP_RGB565_recRead16(const uint8_t *pSrc)
+{
+    return (uint16_t)(pSrc[0] | (pSrc[1] << 8));
+}
+
+static uint32_t BMP_RGB565_recRead32(const uint8_t *pSrc)
+{
+    return (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8) | ((uint32_t)pSrc[2] << 16) | ((uint32_t)pSrc[3] << 24);
+}
+
+static uint64_t BMP_RGB565_recRead64(const uint8_t *pSrc)
+{
+    return (uint64_t)BMP_RGB565_recRead32(pSrc) | ((uint64_t)BMP_RGB565_recRead32(pSrc + 4) << 32);
+}
+
+static void BMP_RGB565_recWrite16(uint16_t Src, uint8_t *pDst)
+{
+    pDst[0] = (uint8_t)Src;
+    pDst[1] = (uint8_t)(Src >> 8);
+}
+
+static void BMP_RGB565_recWrite32(uint32_t Src, uint8_t *pDst)
+{
+    BMP_RGB565_recWrite16((uint16_t)Src, pDst);
+    BMP_RGB565_recWrite16((uint16_t)(Src >> 16), pDst + 2);
+}
+
+static void BMP_RGB565_recWrite64(uint64_t Src, uint8_t *pDst)
+{
+    BMP_RGB565_recWrite32((uint32_t)Src, pDst);
+    BMP_RGB565_recWrite32((uint32_t)(Src >> 32), pDst + 4);
+}
+
+/***************************************************************END OF FILE****/
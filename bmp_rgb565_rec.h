@@ -0,0 +1,56 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef _BMP_RGB565_REC_H_
+#define _BMP_RGB565_REC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Include system header files -----------------------------------------------*/
+#include <stdint.h>
+
+/* Include user header files -------------------------------------------------*/
+#include "bmp_rgb565.h"
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported function macro ---------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/**
+ * Multi-frame recording container (POSIX).
+ * Many RGB565 frames of the same size are appended to one file which holds a single
+ * shared BMP header, per-frame timestamps and an offset index.
+ * Frames are read through mmap, so raw frames are accessed without copying.
+ */
+typedef struct BMP_RGB565_recWriter BMP_RGB565_recWriter_t;
+typedef struct BMP_RGB565_recReader BMP_RGB565_recReader_t;
+
+/* Exported enum tag ---------------------------------------------------------*/
+/* Exported struct/union tag -------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+extern BMP_RGB565_recWriter_t *BMP_RGB565_recCreate(const char *, uint32_t, uint32_t, uint32_t);
+extern int BMP_RGB565_recAppend(BMP_RGB565_recWriter_t *, uint8_t *, uint64_t);
+extern int BMP_RGB565_recClose(BMP_RGB565_recWriter_t *);
+
+extern BMP_RGB565_recReader_t *BMP_RGB565_recOpen(const char *);
+extern void BMP_RGB565_recFree(BMP_RGB565_recReader_t *);
+extern uint32_t BMP_RGB565_recGetWidth(BMP_RGB565_recReader_t *);
+extern uint32_t BMP_RGB565_recGetHeight(BMP_RGB565_recReader_t *);
+extern uint32_t BMP_RGB565_recGetFrameCount(BMP_RGB565_recReader_t *);
+extern uint64_t BMP_RGB565_recGetTimestamp(BMP_RGB565_recReader_t *, uint32_t);
+extern int32_t BMP_RGB565_recFindFrame(BMP_RGB565_recReader_t *, uint64_t);
+extern const uint8_t *BMP_RGB565_recGetHeader(BMP_RGB565_recReader_t *);
+extern const uint16_t *BMP_RGB565_recGetPixels(BMP_RGB565_recReader_t *, uint32_t);
+extern const uint16_t *BMP_RGB565_recGetRow(BMP_RGB565_recReader_t *, uint32_t, uint32_t);
+extern int BMP_RGB565_recReadView(BMP_RGB565_recReader_t *, uint32_t, uint32_t, uint32_t, const BMP_RGB565_view_st *);
+extern int BMP_RGB565_recReadFrame(BMP_RGB565_recReader_t *, uint32_t, uint8_t *);
+extern int BMP_RGB565_recExportFrame(BMP_RGB565_recReader_t *, uint32_t, const char *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BMP_RGB565_REC_H_ */
+
+/***************************************************************END OF FILE****/
@@ -0,0 +1,547 @@
+/* Include system header files -----------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Include user header files -------------------------------------------------*/
+#include "bmp_rgb565_tiled.h"
+
+/* Imported variables --------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+#define BMP_RGB565_TILED_SHIFT  6       // log2(BMP_RGB565_TILED_TILE_SIZE)
+#define BMP_RGB565_TILED_MASK   (BMP_RGB565_TILED_TILE_SIZE - 1)
+#define BMP_RGB565_TILED_PIXELS (BMP_RGB565_TILED_TILE_SIZE * BMP_RGB565_TILED_TILE_SIZE)
+
+#if (1 << BMP_RGB565_TILED_SHIFT) != BMP_RGB565_TILED_TILE_SIZE
+#error "BMP_RGB565_TILED_SHIFT does not match BMP_RGB565_TILED_TILE_SIZE"
+#endif
+
+/* Private types -------------------------------------------------------------*/
+/* Private enum tag ----------------------------------------------------------*/
+/* Private struct/union tag --------------------------------------------------*/
+struct BMP_RGB565_tiled
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t tiles_x;           // number of tiles in a row of tiles
+    uint32_t tiles_y;
+    uint16_t *pixels;           // tiles in row-major order, pixels of a tile in row-major order
+};
+
+/* Private variables ---------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+BMP_RGB565_tiled_t *BMP_RGB565_tiledCreate(uint32_t, uint32_t);
+void      BMP_RGB565_tiledFree       (BMP_RGB565_tiled_t *);
+uint32_t  BMP_RGB565_tiledGetWidth   (BMP_RGB565_tiled_t *);
+uint32_t  BMP_RGB565_tiledGetHeight  (BMP_RGB565_tiled_t *);
+uint16_t *BMP_RGB565_tiledGetTile    (BMP_RGB565_tiled_t *, uint32_t, uint32_t);
+void      BMP_RGB565_tiledSetPixel565(BMP_RGB565_tiled_t *, uint32_t, uint32_t, uint16_t);
+uint16_t  BMP_RGB565_tiledGetPixel565(BMP_RGB565_tiled_t *, uint32_t, uint32_t);
+void      BMP_RGB565_tiledFill565    (BMP_RGB565_tiled_t *, uint16_t);
+int       BMP_RGB565_tiledWriteView  (BMP_RGB565_tiled_t *, int64_t, int64_t, const BMP_RGB565_view_st *);
+int       BMP_RGB565_tiledReadView   (BMP_RGB565_tiled_t *, int64_t, int64_t, const BMP_RGB565_view_st *);
+BMP_RGB565_tiled_t *BMP_RGB565_tiledFromImage(uint8_t *);
+uint8_t * BMP_RGB565_tiledToImage    (BMP_RGB565_tiled_t *, uint32_t, uint32_t, uint32_t, uint32_t);
+BMP_RGB565_tiled_t *BMP_RGB565_tiledRotate90(BMP_RGB565_tiled_t *);
+BMP_RGB565_tiled_t *BMP_RGB565_tiledRotate270(BMP_RGB565_tiled_t *);
+BMP_RGB565_tiled_t *BMP_RGB565_tiledTranspose(BMP_RGB565_tiled_t *);
+void      BMP_RGB565_tiledRotate180  (BMP_RGB565_tiled_t *);
+BMP_RGB565_tiled_t *BMP_RGB565_tiledResizeNearest(BMP_RGB565_tiled_t *, uint32_t, uint32_t);
+int       BMP_RGB565_tiledExport     (BMP_RGB565_tiled_t *, BMP_RGB565_tiledWrite_Function, void *);
+
+/* Private function prototypes -----------------------------------------------*/
+static uint16_t *BMP_RGB565_tiledAddr(BMP_RGB565_tiled_t *, uint32_t, uint32_t);
+static BMP_RGB565_tiled_t *BMP_RGB565_tiledTransform(BMP_RGB565_tiled_t *, bool, bool);
+static bool BMP_RGB565_tiledClip(BMP_RGB565_tiled_t *, int64_t, int64_t, const BMP_RGB565_view_st *,
+        uint32_t *, uint32_t *, uint32_t *, uint32_t *);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Create a tiled image.
+  * @param  width  width of image [pixel]
+  * @param  height height of image [pixel]
+  * @retval pointer to the created image. When error (including a size too large for memory), return NULL
+  * @detail The pixels are cleared to black.
+  */
+BMP_RGB565_tiled_t *BMP_RGB565_tiledCreate(uint32_t width, uint32_t height)
+{
+    if (width == 0 || height == 0)
+        return NULL;
+
+    uint32_t tiles_x = (uint32_t)(((uint64_t)width  + BMP_RGB565_TILED_MASK) >> BMP_RGB565_TILED_SHIFT);
+    uint32_t tiles_y = (uint32_t)(((uint64_t)height + BMP_RGB565_TILED_MASK) >> BMP_RGB565_TILED_SHIFT);
+    uint64_t tiles   = (uint64_t)tiles_x * tiles_y;
+    if (tiles > SIZE_MAX / (BMP_RGB565_TILED_PIXELS * sizeof(uint16_t)))
+        return NULL;
+
+    BMP_RGB565_tiled_t *tiled = (BMP_RGB565_tiled_t *)malloc(sizeof(BMP_RGB565_tiled_t));
+    if (tiled == NULL)
+        return NULL;
+
+    tiled->pixels = (uint16_t *)calloc((size_t)tiles, BMP_RGB565_TILED_PIXELS * sizeof(uint16_t));
+    if (tiled->pixels == NULL)
+    {
+        free(tiled);
+        return NULL;
+    }
+    tiled->width   = width;
+    tiled->height  = height;
+    tiled->tiles_x = tiles_x;
+    tiled->tiles_y = tiles_y;
+    return tiled;
+}
+
+/**
+  * @brief  Free a tiled image.
+  * @param  tiled pointer to a tiled image
+  * @retval None
+  */
+void BMP_RGB565_tiledFree(BMP_RGB565_tiled_t *tiled)
+{
+    if (tiled == NULL)
+        return;
+
+    free(tiled->pixels);
+    free(tiled);
+}
+
+/**
+  * @brief  Get width in pixel of a tiled image.
+  * @param  tiled pointer to a tiled image
+  * @retval width [pixel]
+  */
+uint32_t BMP_RGB565_tiledGetWidth(BMP_RGB565_tiled_t *tiled)
+{
+    return (tiled == NULL) ? 0 : tiled->width;
+}
+
+/**
+  * @brief  Get height in pixel of a tiled image.
+  * @param  tiled pointer to a tiled image
+  * @retval height [pixel]
+  */
+uint32_t BMP_RGB565_tiledGetHeight(BMP_RGB565_tiled_t *tiled)
+{
+    return (tiled == NULL) ? 0 : tiled->height;
+}
+
+/**
+  * @brief  Get a pointer to the pixels of a tile.
+  * @param  tiled pointer to a tiled image
+  * @param  tx    x of the tile (Range:[0,ceil(width/BMP_RGB565_TILED_TILE_SIZE)-1])
+  * @param  ty    y of the tile (Range:[0,ceil(height/BMP_RGB565_TILED_TILE_SIZE)-1])
+  * @retval pointer to BMP_RGB565_TILED_TILE_SIZE^2 pixels in row-major order. When error, return NULL
+  * @detail Pixels are RGB565 values in the byte order of the CPU (unlike BMP_RGB565_getRow()).
+  *         Pixels of edge tiles outside the image are kept but never exported.
+  */
+uint16_t *BMP_RGB565_tiledGetTile(BMP_RGB565_tiled_t *tiled, uint32_t tx, uint32_t ty)
+{
+    if (tiled == NULL || tx >= tiled->tiles_x || ty >= tiled->tiles_y)
+        return NULL;
+
+    return tiled->pixels + ((size_t)ty * tiled->tiles_x + tx) * BMP_RGB565_TILED_PIXELS;
+}
+
+/**
+  * @brief  Draw a RGB565 color on a specified pixel of a tiled image.
+  * @param  tiled pointer to a tiled image
+  * @param  x	x of a image(Range:[0,width-1] ) [pixel]
+  * @param  y	y of a image(Range:[0,height-1]) [pixel]
+  * @param  col	RGB565 color
+  * @retval None
+  */
+void BMP_RGB565_tiledSetPixel565(BMP_RGB565_tiled_t *tiled, uint32_t x, uint32_t y, uint16_t col)
+{
+    if (tiled == NULL || x >= tiled->width || y >= tiled->height)
+        return;
+
+    *BMP_RGB565_tiledAddr(tiled, x, y) = col;
+}
+
+/**
+  * @brief  Get a RGB565 color on a specified pixel of a tiled image.
+  * @param  tiled pointer to a tiled image
+  * @param  x	x of a image(Range:[0,width-1] ) [pixel]
+  * @param  y	y of a image(Range:[0,height-1]) [pixel]
+  * @retval RGB565 color. When out of range, return 0
+  */
+uint16_t BMP_RGB565_tiledGetPixel565(BMP_RGB565_tiled_t *tiled, uint32_t x, uint32_t y)
+{
+    if (tiled == NULL || x >= tiled->width || y >= tiled->height)
+        return 0;
+
+    return *BMP_RGB565_tiledAddr(tiled, x, y);
+}
+
+/**
+  * @brief  Fill a tiled image in a specified RGB565 color.
+  * @param  tiled pointer to a tiled image
+  * @param  col	RGB565 color
+  * @retval None
+  */
+void BMP_RGB565_tiledFill565(BMP_RGB565_tiled_t *tiled, uint16_t col)
+{
+    if (tiled == NULL)
+        return;
+
+    size_t n = (size_t)tiled->tiles_x * tiled->tiles_y * BMP_RGB565_TILED_PIXELS;
+    for (size_t i = 0; i < n; i++)
+        tiled->pixels[i] = col;
+}
+
+/**
+  * @brief  Copy the pixels of a view into a tiled image.
+  * @param  tiled pointer to a tiled image
+  * @param  x     x of the destination of the upper left pixel of the view [pixel]
+  * @param  y     y of the destination of the upper left pixel of the view [pixel]
+  * @param  src   pointer to a source view
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail The copy is clipped to the tiled image, so views can be stitched at any position.
+  */
+int BMP_RGB565_tiledWriteView(BMP_RGB565_tiled_t *tiled, int64_t x, int64_t y, const BMP_RGB565_view_st *src)
+{
+    uint32_t vx, vy, w, h;
+
+    if (tiled == NULL || src == NULL)
+        return -1;
+    if (!BMP_RGB565_tiledClip(tiled, x, y, src, &vx, &vy, &w, &h))
+        return 0;
+
+    for (uint32_t j = 0; j < h; j++)
+    {
+        const uint16_t *row = BMP_RGB565_viewGetRow(src, vy + j) + vx;
+        uint32_t ty = (uint32_t)(y + vy + j);
+        uint32_t tx = (uint32_t)(x + vx);
+        uint32_t i = 0;
+        while (i < w)
+        {
+            // Pixels of the row within one tile
+            uint32_t n = BMP_RGB565_TILED_TILE_SIZE - ((tx + i) & BMP_RGB565_TILED_MASK);
+            if (n > w - i)
+                n = w - i;
+            uint16_t *dst = BMP_RGB565_tiledAddr(tiled, tx + i, ty);
+            for (uint32_t k = 0; k < n; k++)
+                dst[k] = BMP_RGB565_get565(row, i + k);
+            i += n;
+        }
+    }
+    return 0;
+}
+
+/**
+  * @brief  Copy a region of a tiled image into a view.
+  * @param  tiled pointer to a tiled image
+  * @param  x     x of the region in the tiled image [pixel]
+  * @param  y     y of the region in the tiled image [pixel]
+  * @param  dst   pointer to a destination view (its size is the size of the region)
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Pixels of the view outside the tiled image are left unchanged.
+  */
+int BMP_RGB565_tiledReadView(BMP_RGB565_tiled_t *tiled, int64_t x, int64_t y, const BMP_RGB565_view_st *dst)
+{
+    uint32_t vx, vy, w, h;
+
+    if (tiled == NULL || dst == NULL)
+        return -1;
+    if (!BMP_RGB565_tiledClip(tiled, x, y, dst, &vx, &vy, &w, &h))
+        return 0;
+
+    for (uint32_t j = 0; j < h; j++)
+    {
+        uint16_t *row = BMP_RGB565_viewGetRow(dst, vy + j) + vx;
+        uint32_t ty = (uint32_t)(y + vy + j);
+        uint32_t tx = (uint32_t)(x + vx);
+        uint32_t i = 0;
+        while (i < w)
+        {
+            uint32_t n = BMP_RGB565_TILED_TILE_SIZE - ((tx + i) & BMP_RGB565_TILED_MASK);
+            if (n > w - i)
+                n = w - i;
+            const uint16_t *src = BMP_RGB565_tiledAddr(tiled, tx + i, ty);
+            for (uint32_t k = 0; k < n; k++)
+                BMP_RGB565_put565(row, i + k, src[k]);
+            i += n;
+        }
+    }
+    return 0;
+}
+
+/**
+  * @brief  Create a tiled image from an image.
+  * @param  pbmp pointer to a image
+  * @retval pointer to the created tiled image. When error, return NULL
+  */
+BMP_RGB565_tiled_t *BMP_RGB565_tiledFromImage(uint8_t *pbmp)
+{
+    BMP_RGB565_view_st view;
+
+    if (pbmp == NULL || BMP_RGB565_viewInit(&view, pbmp, 0, 0, BMP_RGB565_getWidth(pbmp), BMP_RGB565_getHeight(pbmp)) != 0)
+        return NULL;
+
+    BMP_RGB565_tiled_t *tiled = BMP_RGB565_tiledCreate(view.width, view.height);
+    if (tiled == NULL)
+        return NULL;
+
+    BMP_RGB565_tiledWriteView(tiled, 0, 0, &view);
+    return tiled;
+}
+
+/**
+  * @brief  Copy a region of a tiled image to a new image.
+  * @param  tiled  pointer to a tiled image
+  * @param  x      x of the region [pixel]
+  * @param  y      y of the region [pixel]
+  * @param  width  width of the region [pixel]
+  * @param  height height of the region [pixel]
+  * @retval pointer to the created image. When error, return NULL
+  * @detail The region is clipped to the tiled image. Fails if it is empty or too large for a BMP file.
+  */
+uint8_t *BMP_RGB565_tiledToImage(BMP_RGB565_tiled_t *tiled, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    BMP_RGB565_view_st view;
+
+    if (tiled == NULL || x >= tiled->width || y >= tiled->height)
+        return NULL;
+    if (width > tiled->width - x)
+        width = tiled->width - x;
+    if (height > tiled->height - y)
+        height = tiled->height - y;
+
+    uint8_t *pbmp = BMP_RGB565_create(width, height);
+    if (pbmp == NULL)
+        return NULL;
+
+    if (BMP_RGB565_viewInit(&view, pbmp, 0, 0, width, height) != 0 || BMP_RGB565_tiledReadView(tiled, x, y, &view) != 0)
+    {
+        BMP_RGB565_free(pbmp);
+        return NULL;
+    }
+    return pbmp;
+}
+
+/**
+  * @brief  Rotate a tiled image 90 degrees clockwise.
+  * @param  tiled pointer to a source tiled image
+  * @retval pointer to the created tiled image (width and height are swapped). When error, return NULL
+  */
+BMP_RGB565_tiled_t *BMP_RGB565_tiledRotate90(BMP_RGB565_tiled_t *tiled)
+{
+    return BMP_RGB565_tiledTransform(tiled, false, true);
+}
+
+/**
+  * @brief  Rotate a tiled image 270 degrees clockwise (90 degrees counterclockwise).
+  * @param  tiled pointer to a source tiled image
+  * @retval pointer to the created tiled image (width and height are swapped). When error, return NULL
+  */
+BMP_RGB565_tiled_t *BMP_RGB565_tiledRotate270(BMP_RGB565_tiled_t *tiled)
+{
+    return BMP_RGB565_tiledTransform(tiled, true, false);
+}
+
+/**
+  * @brief  Transpose a tiled image (mirror along the main diagonal).
+  * @param  tiled pointer to a source tiled image
+  * @retval pointer to the created tiled image (width and height are swapped). When error, return NULL
+  */
+BMP_RGB565_tiled_t *BMP_RGB565_tiledTranspose(BMP_RGB565_tiled_t *tiled)
+{
+    return BMP_RGB565_tiledTransform(tiled, false, false);
+}
+
+/**
+  * @brief  Rotate a tiled image 180 degrees in place.
+  * @param  tiled pointer to a tiled image
+  * @retval None
+  * @detail Tiles are swapped pairwise, so two tiles are touched at a time.
+  */
+void BMP_RGB565_tiledRotate180(BMP_RGB565_tiled_t *tiled)
+{
+    if (tiled == NULL)
+        return;
+
+    uint32_t width = tiled->width, height = tiled->height;
+    for (uint32_t ty = 0; ty < tiled->tiles_y; ty++)
+    {
+        for (uint32_t tx = 0; tx < tiled->tiles_x; tx++)
+        {
+            for (uint32_t j = 0; j < BMP_RGB565_TILED_TILE_SIZE; j++)
+            {
+                uint32_t y = (ty << BMP_RGB565_TILED_SHIFT) + j;
+                if (y >= height)
+                    break;
+                for (uint32_t i = 0; i < BMP_RGB565_TILED_TILE_SIZE; i++)
+                {
+                    uint32_t x = (tx << BMP_RGB565_TILED_SHIFT) + i;
+                    if (x >= width)
+                        break;
+
+                    // Swap each pair once: the pixel before its mirror in row-major order
+                    uint32_t mx = width - 1 - x, my = height - 1 - y;
+                    if (y > my || (y == my && x >= mx))
+                        continue;
+                    uint16_t *a = BMP_RGB565_tiledAddr(tiled, x, y);
+                    uint16_t *b = BMP_RGB565_tiledAddr(tiled, mx, my);
+                    uint16_t tmp = *a;
+                    *a = *b;
+                    *b = tmp;
+                }
+            }
+        }
+    }
+}
+
+/**
+  * @brief  Resize a tiled image by nearest neighbor interpolation.
+  * @param  tiled  pointer to a source tiled image
+  * @param  width  width of the resized image [pixel]
+  * @param  height height of the resized image [pixel]
+  * @retval pointer to the created tiled image. When error, return NULL
+  * @detail Each destination tile reads a rectangle of the source, i.e. a few neighboring tiles.
+  */
+BMP_RGB565_tiled_t *BMP_RGB565_tiledResizeNearest(BMP_RGB565_tiled_t *tiled, uint32_t width, uint32_t height)
+{
+    uint32_t src_x[BMP_RGB565_TILED_TILE_SIZE];
+
+    if (tiled == NULL)
+        return NULL;
+
+    BMP_RGB565_tiled_t *dst = BMP_RGB565_tiledCreate(width, height);
+    if (dst == NULL)
+        return NULL;
+
+    for (uint32_t tx = 0; tx < dst->tiles_x; tx++)
+    {
+        for (uint32_t i = 0; i < BMP_RGB565_TILED_TILE_SIZE; i++)
+        {
+            uint64_t x = ((uint64_t)tx << BMP_RGB565_TILED_SHIFT) + i;
+            src_x[i] = (x < width) ? (uint32_t)(x * tiled->width / width) : 0;
+        }
+
+        for (uint32_t ty = 0; ty < dst->tiles_y; ty++)
+        {
+            uint16_t *tile = BMP_RGB565_tiledGetTile(dst, tx, ty);
+            for (uint32_t j = 0; j < BMP_RGB565_TILED_TILE_SIZE; j++)
+            {
+                uint64_t y = ((uint64_t)ty << BMP_RGB565_TILED_SHIFT) + j;
+                if (y >= height)
+                    break;
+                uint32_t sy = (uint32_t)(y * tiled->height / height);
+                for (uint32_t i = 0; i < BMP_RGB565_TILED_TILE_SIZE; i++)
+                    tile[(j << BMP_RGB565_TILED_SHIFT) + i] = *BMP_RGB565_tiledAddr(tiled, src_x[i], sy);
+            }
+        }
+    }
+    return dst;
+}
+
+/**
+  * @brief  Write a tiled image as a standard (linear, bottom-up) BMP file.
+  * @param  tiled    pointer to a tiled image
+  * @param  write_fn output function, called with the header and then with each row
+  * @param  ctx      first argument of write_fn (e.g. a FILE *)
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Only one row is buffered, so images larger than memory can be written to a file.
+  *         Fails if the image exceeds the limits of a BMP file (see BMP_RGB565_initHeader()).
+  */
+int BMP_RGB565_tiledExport(BMP_RGB565_tiled_t *tiled, BMP_RGB565_tiledWrite_Function write_fn, void *ctx)
+{
+    uint8_t header[BMP_RGB565_HEADER_SIZE];
+
+    if (tiled == NULL || write_fn == NULL || BMP_RGB565_initHeader(header, tiled->width, tiled->height) != 0)
+        return -1;
+
+    size_t bytes_per_row = (((size_t)tiled->width << 1) + 3) & ~(size_t)3;
+    uint8_t *row = (uint8_t *)calloc(1, bytes_per_row);
+    if (row == NULL)
+        return -1;
+
+    int status = write_fn(ctx, header, sizeof(header));
+    for (uint32_t y = tiled->height; y-- > 0 && status == 0; )
+    {
+        for (uint32_t tx = 0; tx < tiled->tiles_x; tx++)
+        {
+            uint32_t x0 = tx << BMP_RGB565_TILED_SHIFT;
+            uint32_t n = (tiled->width - x0 < BMP_RGB565_TILED_TILE_SIZE) ? tiled->width - x0 : BMP_RGB565_TILED_TILE_SIZE;
+            const uint16_t *src = BMP_RGB565_tiledAddr(tiled, x0, y);
+            for (uint32_t i = 0; i < n; i++)
+                BMP_RGB565_put565((uint16_t *)row, x0 + i, src[i]);
+        }
+        status = write_fn(ctx, row, bytes_per_row);
+    }
+
+    free(row);
+    return (status == 0) ? 0 : -1;
+}
+
+
+/* Private functions ---------------------------------------------------------*/
+// Calculate the address of a pixel. (No range check)
+static uint16_t *BMP_RGB565_tiledAddr(BMP_RGB565_tiled_t *tiled, uint32_t x, uint32_t y)
+{
+    size_t tile = (size_t)(y >> BMP_RGB565_TILED_SHIFT) * tiled->tiles_x + (x >> BMP_RGB565_TILED_SHIFT);
+    return tiled->pixels + tile * BMP_RGB565_TILED_PIXELS
+         + ((y & BMP_RGB565_TILED_MASK) << BMP_RGB565_TILED_SHIFT) + (x & BMP_RGB565_TILED_MASK);
+}
+
+// Create the transpose of a tiled image, optionally mirrored (see BMP_RGB565_transpose()).
+// Destination tiles are filled one at a time from the few source tiles they map to.
+static BMP_RGB565_tiled_t *BMP_RGB565_tiledTransform(BMP_RGB565_tiled_t *tiled, bool mirror_x, bool mirror_y)
+{
+    if (tiled == NULL)
+        return NULL;
+
+    uint32_t src_width  = tiled->width;
+    uint32_t src_height = tiled->height;
+
+    BMP_RGB565_tiled_t *dst = BMP_RGB565_tiledCreate(src_height, src_width);
+    if (dst == NULL)
+        return NULL;
+
+    for (uint32_t ty = 0; ty < dst->tiles_y; ty++)
+    {
+        for (uint32_t tx = 0; tx < dst->tiles_x; tx++)
+        {
+            uint16_t *tile = BMP_RGB565_tiledGetTile(dst, tx, ty);
+            for (uint32_t j = 0; j < BMP_RGB565_TILED_TILE_SIZE; j++)
+            {
+                uint32_t y = (ty << BMP_RGB565_TILED_SHIFT) + j;
+                if (y >= src_width)
+                    break;
+                uint32_t sx = mirror_x ? src_width - 1 - y : y;
+                for (uint32_t i = 0; i < BMP_RGB565_TILED_TILE_SIZE; i++)
+                {
+                    uint32_t x = (tx << BMP_RGB565_TILED_SHIFT) + i;
+                    if (x >= src_height)
+                        break;
+                    tile[(j << BMP_RGB565_TILED_SHIFT) + i] = *BMP_RGB565_tiledAddr(tiled, sx, mirror_y ? src_height - 1 - x : x);
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+// Clip a view placed at (x, y) to a tiled image.
+// Returns the clipped region in view coordinates, or false if it is empty.
+static bool BMP_RGB565_tiledClip(BMP_RGB565_tiled_t *tiled, int64_t x, int64_t y, const BMP_RGB565_view_st *view,
+        uint32_t *vx, uint32_t *vy, uint32_t *w, uint32_t *h)
+{
+    int64_t x0 = (x < 0) ? -x : 0;
+    int64_t y0 = (y < 0) ? -y : 0;
+    int64_t x1 = view->width, y1 = view->height;
+    if (x + x1 > tiled->width)  x1 = tiled->width  - x;
+    if (y + y1 > tiled->height) y1 = tiled->height - y;
+    if (x0 >= x1 || y0 >= y1)
+        return false;
+
+    *vx = (uint32_t)x0;
+    *vy = (uint32_t)y0;
+    *w  = (uint32_t)(x1 - x0);
+    *h  = (uint32_t)(y1 - y0);
+    return true;
+}
+
+/***************************************************************END OF FILE****/
@@ -0,0 +1,67 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef _BMP_RGB565_TILED_H_
+#define _BMP_RGB565_TILED_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Include system header files -----------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/* Include user header files -------------------------------------------------*/
+#include "bmp_rgb565.h"
+
+/* Exported macro ------------------------------------------------------------*/
+/** @def
+ * Width and height of a tile [pixel]
+ */
+#define BMP_RGB565_TILED_TILE_SIZE  64
+
+/* Exported function macro ---------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/**
+ * Tiled RGB565 image for images far larger than the cache (panoramas, mosaics).
+ * Pixels are stored in tiles of BMP_RGB565_TILED_TILE_SIZE x BMP_RGB565_TILED_TILE_SIZE,
+ * each tile contiguous in memory, so that a region or a column touches few cache lines.
+ * Sizes are only limited by memory (not by the 4 GiB limit of a BMP file).
+ */
+typedef struct BMP_RGB565_tiled BMP_RGB565_tiled_t;
+
+/**
+ * Output function of BMP_RGB565_tiledExport(): write size bytes, return 0 on success
+ */
+typedef int (*BMP_RGB565_tiledWrite_Function)(void *, const void *, size_t);
+
+/* Exported enum tag ---------------------------------------------------------*/
+/* Exported struct/union tag -------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+extern BMP_RGB565_tiled_t *BMP_RGB565_tiledCreate(uint32_t, uint32_t);
+extern void BMP_RGB565_tiledFree(BMP_RGB565_tiled_t *);
+extern uint32_t BMP_RGB565_tiledGetWidth(BMP_RGB565_tiled_t *);
+extern uint32_t BMP_RGB565_tiledGetHeight(BMP_RGB565_tiled_t *);
+extern uint16_t *BMP_RGB565_tiledGetTile(BMP_RGB565_tiled_t *, uint32_t, uint32_t);
+extern void BMP_RGB565_tiledSetPixel565(BMP_RGB565_tiled_t *, uint32_t, uint32_t, uint16_t);
+extern uint16_t BMP_RGB565_tiledGetPixel565(BMP_RGB565_tiled_t *, uint32_t, uint32_t);
+extern void BMP_RGB565_tiledFill565(BMP_RGB565_tiled_t *, uint16_t);
+extern int BMP_RGB565_tiledWriteView(BMP_RGB565_tiled_t *, int64_t, int64_t, const BMP_RGB565_view_st *);
+extern int BMP_RGB565_tiledReadView(BMP_RGB565_tiled_t *, int64_t, int64_t, const BMP_RGB565_view_st *);
+extern BMP_RGB565_tiled_t *BMP_RGB565_tiledFromImage(uint8_t *);
+extern uint8_t *BMP_RGB565_tiledToImage(BMP_RGB565_tiled_t *, uint32_t, uint32_t, uint32_t, uint32_t);
+extern BMP_RGB565_tiled_t *BMP_RGB565_tiledRotate90(BMP_RGB565_tiled_t *);
+extern BMP_RGB565_tiled_t *BMP_RGB565_tiledRotate270(BMP_RGB565_tiled_t *);
+extern BMP_RGB565_tiled_t *BMP_RGB565_tiledTranspose(BMP_RGB565_tiled_t *);
+extern void BMP_RGB565_tiledRotate180(BMP_RGB565_tiled_t *);
+extern BMP_RGB565_tiled_t *BMP_RGB565_tiledResizeNearest(BMP_RGB565_tiled_t *, uint32_t, uint32_t);
+extern int BMP_RGB565_tiledExport(BMP_RGB565_tiled_t *, BMP_RGB565_tiledWrite_Function, void *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BMP_RGB565_TILED_H_ */
+
+/***************************************************************END OF FILE****/
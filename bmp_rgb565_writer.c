@@ -0,0 +1,518 @@
+/* Feature test macro (O_DIRECT, pwrite, clock_gettime) ----------------------*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+/* Include system header files -----------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Include user header files -------------------------------------------------*/
+#include "bmp_rgb565_writer.h"
+
+/* Imported variables --------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+#define BMP_RGB565_WRITER_ALIGN     4096    // Buffer/offset alignment of O_DIRECT [byte]
+#define BMP_RGB565_WRITER_PATH_MAX  256     // Maximum length of a file path (including '\0')
+
+/* Private types -------------------------------------------------------------*/
+/* Private enum tag ----------------------------------------------------------*/
+typedef enum
+{
+    BMP_RGB565_WRITER_FRAME_FREE,       // in free_list
+    BMP_RGB565_WRITER_FRAME_ACQUIRED,   // owned by the producer
+    BMP_RGB565_WRITER_FRAME_QUEUED      // in queue or being written
+} BMP_RGB565_writerFrameState_t;
+
+/* Private struct/union tag --------------------------------------------------*/
+typedef struct
+{
+    uint8_t *pbmp;
+    BMP_RGB565_writerFrameState_t state;
+    char path[BMP_RGB565_WRITER_PATH_MAX];
+} BMP_RGB565_writerFrame_st;
+
+struct BMP_RGB565_writer
+{
+    uint32_t file_size;
+    uint32_t flags;
+    uint32_t fsync_batch;
+
+    BMP_RGB565_writerFrame_st *frames;
+    uint32_t frame_count;
+
+    uint32_t *free_list;        // stack of free frame indices
+    uint32_t free_count;
+    uint32_t *queue;            // FIFO of submitted frame indices
+    uint32_t queue_head;
+    uint32_t queue_count;
+    int *sync_fds;              // written files waiting for a batched fsync
+    uint32_t sync_count;
+
+    bool busy;                  // background thread is writing a frame
+    bool flush_request;
+    bool stop;
+    BMP_RGB565_writerStats_st stats;
+    uint64_t flushed_errors;    // stats.write_errors at the end of the last flush
+
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond_free;   // a frame was returned to the free list
+    pthread_cond_t cond_queue;  // a frame was submitted (or stop/flush requested)
+    pthread_cond_t cond_idle;   // queue drained and batched files synced
+};
+
+/* Private variables ---------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+BMP_RGB565_writer_t *BMP_RGB565_writerCreate(uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
+void      BMP_RGB565_writerDestroy   (BMP_RGB565_writer_t *);
+uint8_t * BMP_RGB565_writerAcquire   (BMP_RGB565_writer_t *);
+uint8_t * BMP_RGB565_writerTryAcquire(BMP_RGB565_writer_t *);
+int       BMP_RGB565_writerSubmit    (BMP_RGB565_writer_t *, uint8_t *, const char *);
+int       BMP_RGB565_writerRelease   (BMP_RGB565_writer_t *, uint8_t *);
+int       BMP_RGB565_writerFlush     (BMP_RGB565_writer_t *);
+void      BMP_RGB565_writerGetStats  (BMP_RGB565_writer_t *, BMP_RGB565_writerStats_st *);
+
+/* Private function prototypes -----------------------------------------------*/
+static void *BMP_RGB565_writerThread(void *);
+static int BMP_RGB565_writerWriteFile(BMP_RGB565_writer_t *, const BMP_RGB565_writerFrame_st *);
+static int BMP_RGB565_writerSyncAll(int *, uint32_t);
+static int BMP_RGB565_writerPwriteAll(int, const uint8_t *, size_t, off_t);
+static int32_t BMP_RGB565_writerFindFrame(BMP_RGB565_writer_t *, uint8_t *);
+static uint8_t *BMP_RGB565_writerTake(BMP_RGB565_writer_t *);
+static uint64_t BMP_RGB565_writerNow_us(void);
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Create an asynchronous frame writer.
+  * @param  width       width of images [pixel]
+  * @param  height      height of images [pixel]
+  * @param  frames      number of pre-allocated images in the ring (>= 1)
+  * @param  flags       BMP_RGB565_WRITER_* flags
+  * @param  fsync_batch number of files synced together. 0: no fsync
+  * @retval pointer to the writer. When error (including a size too large for a BMP file), return NULL
+  * @detail Images are allocated aligned for O_DIRECT and are not affected by
+  *         BMP_RGB565_setAllocFunc().
+  */
+BMP_RGB565_writer_t *BMP_RGB565_writerCreate(uint32_t width, uint32_t height, uint32_t frames, uint32_t flags, uint32_t fsync_batch)
+{
+    // Sizes beyond the limits of a BMP file have no file size
+    if (frames == 0 || BMP_RGB565_calcFileSize(width, height) == 0)
+        return NULL;
+
+    BMP_RGB565_writer_t *writer = (BMP_RGB565_writer_t *)calloc(1, sizeof(BMP_RGB565_writer_t));
+    if (writer == NULL)
+        return NULL;
+
+    writer->file_size   = BMP_RGB565_calcFileSize(width, height);
+    writer->flags       = flags;
+    writer->fsync_batch = fsync_batch;
+    writer->frame_count = frames;
+    writer->frames      = (BMP_RGB565_writerFrame_st *)calloc(frames, sizeof(BMP_RGB565_writerFrame_st));
+    writer->free_list   = (uint32_t *)calloc(frames, sizeof(uint32_t));
+    writer->queue       = (uint32_t *)calloc(frames, sizeof(uint32_t));
+    writer->sync_fds    = (int *)calloc(fsync_batch > 0 ? fsync_batch : 1, sizeof(int));
+    if (writer->frames == NULL || writer->free_list == NULL || writer->queue == NULL || writer->sync_fds == NULL)
+        goto error;
+
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        void *p;
+        if (posix_memalign(&p, BMP_RGB565_WRITER_ALIGN, writer->file_size) != 0)
+            goto error;
+        writer->frames[i].pbmp = (uint8_t *)p;
+        BMP_RGB565_init(writer->frames[i].pbmp, width, height);
+        writer->free_list[writer->free_count++] = i;
+    }
+
+    pthread_mutex_init(&writer->lock, NULL);
+    pthread_cond_init(&writer->cond_free, NULL);
+    pthread_cond_init(&writer->cond_queue, NULL);
+    pthread_cond_init(&writer->cond_idle, NULL);
+    if (pthread_create(&writer->thread, NULL, BMP_RGB565_writerThread, writer) != 0)
+    {
+        pthread_mutex_destroy(&writer->lock);
+        pthread_cond_destroy(&writer->cond_free);
+        pthread_cond_destroy(&writer->cond_queue);
+        pthread_cond_destroy(&writer->cond_idle);
+        goto error;
+    }
+    return writer;
+
+error:
+    if (writer->frames != NULL)
+        for (uint32_t i = 0; i < frames; i++)
+            free(writer->frames[i].pbmp);
+    free(writer->frames);
+    free(writer->free_list);
+    free(writer->queue);
+    free(writer->sync_fds);
+    free(writer);
+    return NULL;
+}
+
+/**
+  * @brief  Write all submitted images, stop the background thread and free the writer.
+  * @param  writer pointer to a writer
+  * @retval None
+  * @detail Images acquired by the producer become invalid.
+  */
+void BMP_RGB565_writerDestroy(BMP_RGB565_writer_t *writer)
+{
+    if (writer == NULL)
+        return;
+
+    BMP_RGB565_writerFlush(writer);
+
+    pthread_mutex_lock(&writer->lock);
+    writer->stop = true;
+    pthread_cond_signal(&writer->cond_queue);
+    pthread_mutex_unlock(&writer->lock);
+    pthread_join(writer->thread, NULL);
+
+    pthread_mutex_destroy(&writer->lock);
+    pthread_cond_destroy(&writer->cond_free);
+    pthread_cond_destroy(&writer->cond_queue);
+    pthread_cond_destroy(&writer->cond_idle);
+    for (uint32_t i = 0; i < writer->frame_count; i++)
+        free(writer->frames[i].pbmp);
+    free(writer->frames);
+    free(writer->free_list);
+    free(writer->queue);
+    free(writer->sync_fds);
+    free(writer);
+}
+
+/**
+  * @brief  Get a free image from the ring. Blocks while every image is in use (backpressure).
+  * @param  writer pointer to a writer
+  * @retval pointer to an image. When error, return NULL
+  * @detail The image keeps the pixels of its previous use.
+  */
+uint8_t *BMP_RGB565_writerAcquire(BMP_RGB565_writer_t *writer)
+{
+    if (writer == NULL)
+        return NULL;
+
+    pthread_mutex_lock(&writer->lock);
+    if (writer->free_count == 0)
+        writer->stats.producer_waits++;
+    while (writer->free_count == 0)
+        pthread_cond_wait(&writer->cond_free, &writer->lock);
+    uint8_t *pbmp = BMP_RGB565_writerTake(writer);
+    pthread_mutex_unlock(&writer->lock);
+    return pbmp;
+}
+
+/**
+  * @brief  Get a free image from the ring without blocking.
+  * @param  writer pointer to a writer
+  * @retval pointer to an image. When every image is in use, return NULL
+  */
+uint8_t *BMP_RGB565_writerTryAcquire(BMP_RGB565_writer_t *writer)
+{
+    uint8_t *pbmp = NULL;
+
+    if (writer == NULL)
+        return NULL;
+
+    pthread_mutex_lock(&writer->lock);
+    if (writer->free_count > 0)
+        pbmp = BMP_RGB565_writerTake(writer);
+    pthread_mutex_unlock(&writer->lock);
+    return pbmp;
+}
+
+/**
+  * @brief  Queue an acquired image to be written to a file.
+  * @param  writer pointer to a writer
+  * @param  pbmp   pointer to an image from BMP_RGB565_writerAcquire()
+  * @param  path   file path
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail The image must not be touched after this call. It returns to the ring
+  *         when the file has been written.
+  *         Fails if the image is not currently acquired (e.g. submitted twice).
+  */
+int BMP_RGB565_writerSubmit(BMP_RGB565_writer_t *writer, uint8_t *pbmp, const char *path)
+{
+    if (writer == NULL || path == NULL || strlen(path) >= BMP_RGB565_WRITER_PATH_MAX)
+        return -1;
+
+    int32_t index = BMP_RGB565_writerFindFrame(writer, pbmp);
+    if (index < 0)
+        return -1;
+
+    pthread_mutex_lock(&writer->lock);
+    if (writer->frames[index].state != BMP_RGB565_WRITER_FRAME_ACQUIRED)
+    {
+        pthread_mutex_unlock(&writer->lock);
+        return -1;
+    }
+    strcpy(writer->frames[index].path, path);
+    writer->frames[index].state = BMP_RGB565_WRITER_FRAME_QUEUED;
+    writer->queue[(writer->queue_head + writer->queue_count) % writer->frame_count] = (uint32_t)index;
+    writer->queue_count++;
+    if (writer->queue_count > writer->stats.max_queue_depth)
+        writer->stats.max_queue_depth = writer->queue_count;
+    pthread_cond_signal(&writer->cond_queue);
+    pthread_mutex_unlock(&writer->lock);
+    return 0;
+}
+
+/**
+  * @brief  Return an acquired image to the ring without writing it.
+  * @param  writer pointer to a writer
+  * @param  pbmp   pointer to an image from BMP_RGB565_writerAcquire()
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Fails if the image is not currently acquired (e.g. already submitted or released).
+  */
+int BMP_RGB565_writerRelease(BMP_RGB565_writer_t *writer, uint8_t *pbmp)
+{
+    int32_t index = BMP_RGB565_writerFindFrame(writer, pbmp);
+    if (index < 0)
+        return -1;
+
+    pthread_mutex_lock(&writer->lock);
+    if (writer->frames[index].state != BMP_RGB565_WRITER_FRAME_ACQUIRED)
+    {
+        pthread_mutex_unlock(&writer->lock);
+        return -1;
+    }
+    writer->frames[index].state = BMP_RGB565_WRITER_FRAME_FREE;
+    writer->free_list[writer->free_count++] = (uint32_t)index;
+    pthread_cond_signal(&writer->cond_free);
+    pthread_mutex_unlock(&writer->lock);
+    return 0;
+}
+
+/**
+  * @brief  Wait until every submitted image is written (and synced, if fsync is enabled).
+  * @param  writer pointer to a writer
+  * @retval status (0: Success, otherwise: Failure)
+  * @detail Fails if a write or fsync failed since the previous flush (see BMP_RGB565_writerGetStats()).
+  */
+int BMP_RGB565_writerFlush(BMP_RGB565_writer_t *writer)
+{
+    if (writer == NULL)
+        return -1;
+
+    pthread_mutex_lock(&writer->lock);
+    writer->flush_request = true;
+    pthread_cond_signal(&writer->cond_queue);
+    while (writer->queue_count > 0 || writer->busy || writer->sync_count > 0)
+        pthread_cond_wait(&writer->cond_idle, &writer->lock);
+    writer->flush_request = false;
+    int status = (writer->stats.write_errors == writer->flushed_errors) ? 0 : -1;
+    writer->flushed_errors = writer->stats.write_errors;
+    pthread_mutex_unlock(&writer->lock);
+    return status;
+}
+
+/**
+  * @brief  Get statistics of a writer.
+  * @param  writer pointer to a writer
+  * @param  stats  pointer to statistics
+  * @retval None
+  */
+void BMP_RGB565_writerGetStats(BMP_RGB565_writer_t *writer, BMP_RGB565_writerStats_st *stats)
+{
+    if (writer == NULL || stats == NULL)
+        return;
+
+    pthread_mutex_lock(&writer->lock);
+    *stats = writer->stats;
+    stats->queue_depth = writer->queue_count;
+    pthread_mutex_unlock(&writer->lock);
+}
+
+
+/* Private functions ---------------------------------------------------------*/
+// Background thread: write queued images in submission order.
+static void *BMP_RGB565_writerThread(void *arg)
+{
+    BMP_RGB565_writer_t *writer = (BMP_RGB565_writer_t *)arg;
+
+    pthread_mutex_lock(&writer->lock);
+    for (;;)
+    {
+        while (writer->queue_count == 0 && !writer->stop && !(writer->flush_request && writer->sync_count > 0))
+        {
+            if (writer->sync_count == 0)
+                pthread_cond_broadcast(&writer->cond_idle);
+            pthread_cond_wait(&writer->cond_queue, &writer->lock);
+        }
+
+        if (writer->queue_count == 0)
+        {
+            if (writer->sync_count > 0)
+            {
+                // Flush requested: sync the partial batch
+                uint32_t count = writer->sync_count;
+                writer->busy = true;
+                pthread_mutex_unlock(&writer->lock);
+                int errors = BMP_RGB565_writerSyncAll(writer->sync_fds, count);
+                pthread_mutex_lock(&writer->lock);
+                writer->busy = false;
+                writer->sync_count = 0;
+                writer->stats.write_errors += errors;
+                continue;
+            }
+            break;  // stop
+        }
+
+        uint32_t index = writer->queue[writer->queue_head];
+        writer->queue_head = (writer->queue_head + 1) % writer->frame_count;
+        writer->queue_count--;
+        writer->busy = true;
+        pthread_mutex_unlock(&writer->lock);
+
+        uint64_t start = BMP_RGB565_writerNow_us();
+        int fd = BMP_RGB565_writerWriteFile(writer, &writer->frames[index]);
+        int errors = (fd < 0) ? 1 : 0;
+        bool batch_full = false;
+
+        if (fd >= 0 && writer->fsync_batch == 0)
+            close(fd);
+        else if (fd >= 0)
+        {
+            // sync_fds is only modified by this thread
+            writer->sync_fds[writer->sync_count] = fd;
+            batch_full = (writer->sync_count + 1 >= writer->fsync_batch);
+            if (batch_full)
+                errors += BMP_RGB565_writerSyncAll(writer->sync_fds, writer->sync_count + 1);
+        }
+        uint64_t latency = BMP_RGB565_writerNow_us() - start;
+
+        pthread_mutex_lock(&writer->lock);
+        if (fd >= 0 && writer->fsync_batch > 0)
+            writer->sync_count = batch_full ? 0 : writer->sync_count + 1;
+        writer->busy = false;
+        writer->stats.write_errors += errors;
+        if (fd >= 0)
+        {
+            writer->stats.frames_written++;
+            writer->stats.bytes_written += writer->file_size;
+        }
+        writer->stats.last_latency_us = latency;
+        writer->stats.total_latency_us += latency;
+        if (latency > writer->stats.max_latency_us)
+            writer->stats.max_latency_us = latency;
+        writer->frames[index].state = BMP_RGB565_WRITER_FRAME_FREE;
+        writer->free_list[writer->free_count++] = index;
+        pthread_cond_signal(&writer->cond_free);
+    }
+    pthread_mutex_unlock(&writer->lock);
+    return NULL;
+}
+
+// Write an image to its file. Returns the open file descriptor, or -1 on error.
+static int BMP_RGB565_writerWriteFile(BMP_RGB565_writer_t *writer, const BMP_RGB565_writerFrame_st *frame)
+{
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    bool direct = false;
+    int fd = -1;
+
+#ifdef O_DIRECT
+    if (writer->flags & BMP_RGB565_WRITER_O_DIRECT)
+    {
+        fd = open(frame->path, flags | O_DIRECT, 0644);
+        direct = (fd >= 0);
+    }
+#endif
+    if (fd < 0)
+        fd = open(frame->path, flags, 0644);    // No O_DIRECT (or not supported by the file system)
+    if (fd < 0)
+        return -1;
+
+    size_t size = writer->file_size;
+    size_t body = direct ? size & ~(size_t)(BMP_RGB565_WRITER_ALIGN - 1) : size;
+
+    if (BMP_RGB565_writerPwriteAll(fd, frame->pbmp, body, 0) != 0)
+    {
+        // Some file systems accept O_DIRECT in open() but reject the write: write buffered
+        if (!direct || errno != EINVAL)
+            goto error;
+        body = 0;
+    }
+    if (body < size)
+    {
+        // The unaligned tail (or the whole file, see above) cannot be written with O_DIRECT
+#ifdef O_DIRECT
+        if (direct && fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT) != 0)
+            goto error;
+#endif
+        if (BMP_RGB565_writerPwriteAll(fd, frame->pbmp + body, size - body, (off_t)body) != 0)
+            goto error;
+    }
+    return fd;
+
+error:
+    close(fd);
+    return -1;
+}
+
+// fsync and close files. Returns the number of errors.
+static int BMP_RGB565_writerSyncAll(int *fds, uint32_t count)
+{
+    int errors = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (fsync(fds[i]) != 0)
+            errors++;
+        close(fds[i]);
+    }
+    return errors;
+}
+
+static int BMP_RGB565_writerPwriteAll(int fd, const uint8_t *pSrc, size_t size, off_t offset)
+{
+    while (size > 0)
+    {
+        ssize_t written = pwrite(fd, pSrc, size, offset);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return -1;
+        pSrc   += written;
+        size   -= (size_t)written;
+        offset += written;
+    }
+    return 0;
+}
+
+static int32_t BMP_RGB565_writerFindFrame(BMP_RGB565_writer_t *writer, uint8_t *pbmp)
+{
+    if (writer == NULL || pbmp == NULL)
+        return -1;
+
+    for (uint32_t i = 0; i < writer->frame_count; i++)
+        if (writer->frames[i].pbmp == pbmp)
+            return (int32_t)i;
+    return -1;
+}
+
+// Pop a free image and mark it acquired. (Called with the lock held and free_count > 0)
+static uint8_t *BMP_RGB565_writerTake(BMP_RGB565_writer_t *writer)
+{
+    uint32_t index = writer->free_list[--writer->free_count];
+    writer->frames[index].state = BMP_RGB565_WRITER_FRAME_ACQUIRED;
+    return writer->frames[index].pbmp;
+}
+
+static uint64_t BMP_RGB565_writerNow_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+/***************************************************************END OF FILE****/
@@ -0,0 +1,63 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef _BMP_RGB565_WRITER_H_
+#define _BMP_RGB565_WRITER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Include system header files -----------------------------------------------*/
+#include <stdint.h>
+
+/* Include user header files -------------------------------------------------*/
+#include "bmp_rgb565.h"
+
+/* Exported macro ------------------------------------------------------------*/
+/** @def
+ * Flags of BMP_RGB565_writerCreate()
+ */
+#define BMP_RGB565_WRITER_O_DIRECT  0x00000001  // Bypass the page cache (if supported)
+
+/* Exported function macro ---------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/**
+ * Asynchronous frame writer (POSIX threads).
+ * A small ring of pre-allocated images is shared between the producer and a
+ * background thread which writes submitted images to files.
+ */
+typedef struct BMP_RGB565_writer BMP_RGB565_writer_t;
+
+/* Exported enum tag ---------------------------------------------------------*/
+/* Exported struct/union tag -------------------------------------------------*/
+typedef struct
+{
+   uint32_t queue_depth;        // images waiting to be written
+   uint32_t max_queue_depth;    // maximum of queue_depth
+   uint64_t frames_written;
+   uint64_t bytes_written;
+   uint64_t write_errors;
+   uint64_t producer_waits;     // BMP_RGB565_writerAcquire() calls blocked by a full ring
+   uint64_t last_latency_us;    // open + write (+ fsync) time of the last image [us]
+   uint64_t max_latency_us;
+   uint64_t total_latency_us;
+} BMP_RGB565_writerStats_st;
+
+/* Exported variables --------------------------------------------------------*/
+/* Exported function prototypes ----------------------------------------------*/
+extern BMP_RGB565_writer_t *BMP_RGB565_writerCreate(uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
+extern void BMP_RGB565_writerDestroy(BMP_RGB565_writer_t *);
+extern uint8_t *BMP_RGB565_writerAcquire(BMP_RGB565_writer_t *);
+extern uint8_t *BMP_RGB565_writerTryAcquire(BMP_RGB565_writer_t *);
+extern int BMP_RGB565_writerSubmit(BMP_RGB565_writer_t *, uint8_t *, const char *);
+extern int BMP_RGB565_writerRelease(BMP_RGB565_writer_t *, uint8_t *);
+extern int BMP_RGB565_writerFlush(BMP_RGB565_writer_t *);
+extern void BMP_RGB565_writerGetStats(BMP_RGB565_writer_t *, BMP_RGB565_writerStats_st *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BMP_RGB565_WRITER_H_ */
+
+/***************************************************************END OF FILE****/
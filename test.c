@@ -1,6 +1,540 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include "bmp_rgb565.h"
+#include "bmp_rgb565_writer.h"
+#include "bmp_rgb565_rec.h"
+#include "bmp_rgb565_tiled.h"
+
+static int failures = 0;
+
+#define CHECK(_COND_) do { \
+    if(!(_COND_)) { \
+      printf("FAILED: %s (line %d)\n", #_COND_, __LINE__); \
+      failures++; \
+    } \
+  } while(0)
+
+// Create an image filled with a pattern which differs in every pixel
+static uint8_t *createPattern(uint32_t width, uint32_t height)
+{
+  uint8_t *pbmp = BMP_RGB565_create(width, height);
+  if(pbmp == NULL)
+    return NULL;
+  for(uint32_t y = 0; y < height; y++)
+    for(uint32_t x = 0; x < width; x++)
+      BMP_RGB565_setPixel565(pbmp, x, y, (uint16_t)(y * width + x + 1));
+  return pbmp;
+}
+
+static int isSameImage(uint8_t *pbmp1, uint8_t *pbmp2)
+{
+  return pbmp1 != NULL && pbmp2 != NULL
+      && BMP_RGB565_getFileSize(pbmp1) == BMP_RGB565_getFileSize(pbmp2)
+      && memcmp(pbmp1, pbmp2, BMP_RGB565_getFileSize(pbmp1)) == 0;
+}
+
+static void testPixel565(void)
+{
+  uint8_t *pbmp = BMP_RGB565_create(5, 3);
+  uint8_t r, g, b;
+
+  BMP_RGB565_setPixelRGB(pbmp, 4, 2, COL_RGB_SET(0xFF0000));
+  CHECK(BMP_RGB565_getPixel565(pbmp, 4, 2) == 0xF800);
+  BMP_RGB565_setPixel565(pbmp, 1, 0, 0x07E0);
+  BMP_RGB565_getPixelRGB(pbmp, 1, 0, &r, &g, &b);
+  CHECK(r == 0 && g == 0xFF && b == 0);
+  CHECK(BMP_RGB565_get565(BMP_RGB565_getRow(pbmp, 0), 1) == 0x07E0);
+  CHECK(BMP_RGB565_get565(BMP_RGB565_getRow(pbmp, 2), 4) == 0xF800);
+  CHECK(BMP_RGB565_getRow(pbmp, 3) == NULL);
+  CHECK(BMP_RGB565_getPixel565(pbmp, 5, 0) == 0);
+  BMP_RGB565_free(pbmp);
+}
+
+static void testRotate(void)
+{
+  // Not a multiple of the transpose tile size
+  const uint32_t w = 37, h = 21;
+  uint8_t *src = createPattern(w, h);
+  uint8_t *rot90  = BMP_RGB565_rotate90(src);
+  uint8_t *rot270 = BMP_RGB565_rotate270(src);
+  uint8_t *trans  = BMP_RGB565_transpose(src);
+  int same90 = 1, same270 = 1, sameTrans = 1;
+
+  CHECK(BMP_RGB565_getWidth(rot90) == h && BMP_RGB565_getHeight(rot90) == w);
+  for(uint32_t y = 0; y < w; y++) {
+    for(uint32_t x = 0; x < h; x++) {
+      same90    &= BMP_RGB565_getPixel565(rot90,  x, y) == BMP_RGB565_getPixel565(src, y, h - 1 - x);
+      same270   &= BMP_RGB565_getPixel565(rot270, x, y) == BMP_RGB565_getPixel565(src, w - 1 - y, x);
+      sameTrans &= BMP_RGB565_getPixel565(trans,  x, y) == BMP_RGB565_getPixel565(src, y, x);
+    }
+  }
+  CHECK(same90);
+  CHECK(same270);
+  CHECK(sameTrans);
+
+  // Round-trips
+  uint8_t *back = BMP_RGB565_rotate270(rot90);
+  CHECK(isSameImage(back, src));
+  BMP_RGB565_free(back);
+  back = BMP_RGB565_transpose(trans);
+  CHECK(isSameImage(back, src));
+  BMP_RGB565_free(back);
+
+  uint8_t *copy = BMP_RGB565_copy(src);
+  BMP_RGB565_rotate180(copy);
+  CHECK(BMP_RGB565_getPixel565(copy, 0, 0) == BMP_RGB565_getPixel565(src, w - 1, h - 1));
+  BMP_RGB565_flipHorizontal(copy);
+  BMP_RGB565_flipVertical(copy);
+  CHECK(isSameImage(copy, src));
+  BMP_RGB565_flipHorizontal(copy);
+  CHECK(BMP_RGB565_getPixel565(copy, 0, 3) == BMP_RGB565_getPixel565(src, w - 1, 3));
+  BMP_RGB565_flipHorizontal(copy);
+  CHECK(isSameImage(copy, src));
+
+  BMP_RGB565_free(copy);
+  BMP_RGB565_free(rot90);
+  BMP_RGB565_free(rot270);
+  BMP_RGB565_free(trans);
+  BMP_RGB565_free(src);
+}
+
+static void testScroll(void)
+{
+  const uint32_t w = 23, h = 17;
+  const uint32_t x0 = 3, y0 = 2, x1 = 19, y1 = 14;
+  const int32_t dx = -4, dy = 5;
+  uint8_t *src = createPattern(w, h);
+  uint8_t *dst = BMP_RGB565_copy(src);
+  int same = 1;
+
+  BMP_RGB565_scroll565(dst, x0, y0, x1, y1, dx, dy, 0xFFFF);
+  for(uint32_t y = 0; y < h; y++) {
+    for(uint32_t x = 0; x < w; x++) {
+      int64_t sx = (int64_t)x - dx, sy = (int64_t)y - dy;
+      uint16_t expected;
+      if(x < x0 || x > x1 || y < y0 || y > y1)
+        expected = BMP_RGB565_getPixel565(src, x, y);
+      else if(sx < x0 || sx > x1 || sy < y0 || sy > y1)
+        expected = 0xFFFF;
+      else
+        expected = BMP_RGB565_getPixel565(src, (uint32_t)sx, (uint32_t)sy);
+      same &= BMP_RGB565_getPixel565(dst, x, y) == expected;
+    }
+  }
+  CHECK(same);
+
+  // A ring buffer scrolled and flattened equals the whole image scrolled in place
+  const int32_t shifts[][2] = {{3, -2}, {-5, 4}, {0, 7}, {-1, -1}};
+  uint8_t *ringImage = BMP_RGB565_copy(src);
+  BMP_RGB565_ring_st ring;
+  BMP_RGB565_ringInit(&ring, ringImage);
+  BMP_RGB565_free(dst);
+  dst = BMP_RGB565_copy(src);
+  for(uint32_t i = 0; i < sizeof(shifts) / sizeof(shifts[0]); i++) {
+    BMP_RGB565_scroll565(dst, 0, 0, w - 1, h - 1, shifts[i][0], shifts[i][1], (uint16_t)(0x1000 * i));
+    BMP_RGB565_ringScroll565(&ring, shifts[i][0], shifts[i][1], (uint16_t)(0x1000 * i));
+  }
+  same = 1;
+  for(uint32_t y = 0; y < h; y++)
+    for(uint32_t x = 0; x < w; x++)
+      same &= BMP_RGB565_ringGetPixel565(&ring, x, y) == BMP_RGB565_getPixel565(dst, x, y);
+  CHECK(same);
+  BMP_RGB565_ringFlatten(&ring);
+  CHECK(isSameImage(ringImage, dst));
+
+  BMP_RGB565_free(ringImage);
+  BMP_RGB565_free(dst);
+  BMP_RGB565_free(src);
+}
+
+static void testStatistics(void)
+{
+  float values[100];
+  uint16_t raw[100];
+  uint32_t bins[10], total = 0;
+  BMP_RGB565_stats_st stats;
+  BMP_RGB565_range_st range = {0};
+
+  for(uint32_t i = 0; i < 100; i++) {
+    values[i] = (float)i;
+    raw[i] = (uint16_t)i;
+  }
+  CHECK(BMP_RGB565_statsFloat(values, 100, &stats) == 0);
+  CHECK(stats.min == 0.0f && stats.max == 99.0f && stats.mean == 49.5f);
+  CHECK(BMP_RGB565_statsUint16(raw, 100, &stats) == 0);
+  CHECK(stats.min == 0.0f && stats.max == 99.0f && stats.mean == 49.5f);
+  CHECK(BMP_RGB565_histogramFloat(values, 100, 0.0f, 100.0f, bins, 10) == 0);
+  CHECK(bins[0] == 10 && bins[9] == 10);
+  CHECK(BMP_RGB565_histogramPercentile(bins, 10, 0.0f, 100.0f, 50.0f) == 50.0f);
+
+  // Non-finite values (dead pixels) are ignored
+  values[0]  = NAN;
+  values[50] = INFINITY;
+  values[99] = -INFINITY;
+  CHECK(BMP_RGB565_statsFloat(values, 100, &stats) == 0);
+  CHECK(stats.min == 1.0f && stats.max == 98.0f);
+  CHECK(BMP_RGB565_histogramFloat(values, 100, 0.0f, 100.0f, bins, 10) == 0);
+  for(uint32_t i = 0; i < 10; i++)
+    total += bins[i];
+  CHECK(total == 97);
+  CHECK(BMP_RGB565_autoRangeFloat(values, 100, 0.0f, 100.0f, 1.0f, &range) == 0);
+  CHECK(range.minVal == 1.0f && range.maxVal == 98.0f);
+  BMP_RGB565_rangeUpdate(&range, NAN, 10.0f, 1.0f);
+  CHECK(range.minVal == 1.0f && range.maxVal == 98.0f);
+}
+
+static void testPackedFont(void)
+{
+  static uint8_t blob[4096];
+  BMP_RGB565_packedFont_st font;
+  uint32_t width, height;
+
+  // Codes 0..'9', only the digits 0-3 kept
+  size_t size = BMP_RGB565_packFont(BMP_RGB565_FONT_6X10, 0, '9', "0123", NULL, 0);
+  CHECK(size > 0 && size <= sizeof(blob));
+  CHECK(BMP_RGB565_packFont(BMP_RGB565_FONT_6X10, 0, '9', "0123", blob, sizeof(blob)) == size);
+  CHECK(BMP_RGB565_loadPackedFont(blob, size, &font) == 0);
+  CHECK(size == 12 + ('9' + 1) * 4 + 4 * ((6 * 10 + 7) / 8));  // glyph 0 is not kept
+
+  // Same pixels as the full font
+  uint8_t *packed = BMP_RGB565_create(40, 12);
+  uint8_t *full   = BMP_RGB565_create(40, 12);
+  BMP_RGB565_drawTextPacked565(packed, "3120", &font, 1, 1, 0xFFFF);
+  BMP_RGB565_drawText565(full, "3120", BMP_RGB565_FONT_6X10, 1, 1, 0xFFFF);
+  CHECK(isSameImage(packed, full));
+
+  // Characters without a glyph are left blank
+  BMP_RGB565_drawTextPacked565(packed, "9", &font, 30, 1, 0xFFFF);
+  CHECK(isSameImage(packed, full));
+
+  BMP_RGB565_measureTextPacked("3120", &font, &width, &height);
+  CHECK(width == 24 && height == 10);
+  BMP_RGB565_measureText("3120", BMP_RGB565_FONT_6X10, &width, &height);
+  CHECK(width == 24 && height == 10);
+
+  BMP_RGB565_free(packed);
+  BMP_RGB565_free(full);
+}
+
+static void testFilter(void)
+{
+  const BMP_RGB565_filter_t types[] = {
+    BMP_RGB565_FILTER_BOX, BMP_RGB565_FILTER_GAUSSIAN, BMP_RGB565_FILTER_SHARPEN, BMP_RGB565_FILTER_MEDIAN3X3
+  };
+  const uint32_t w = 29, h = 19;
+  uint8_t *src = createPattern(w, h);
+  float values[29 * 19], inPlace[29 * 19], outOfPlace[29 * 19];
+
+  for(uint32_t i = 0; i < w * h; i++)
+    values[i] = (float)((i * 7919) % 101);
+
+  for(uint32_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    uint8_t *dst  = BMP_RGB565_create(w, h);
+    uint8_t *copy = BMP_RGB565_copy(src);
+    CHECK(BMP_RGB565_filter(src, dst, types[t], 2.0f) == 0);
+    CHECK(BMP_RGB565_filter(copy, copy, types[t], 2.0f) == 0);
+    CHECK(isSameImage(copy, dst));
+
+    memcpy(inPlace, values, sizeof(values));
+    CHECK(BMP_RGB565_filterFloat(values, outOfPlace, w, h, types[t], 2.0f) == 0);
+    CHECK(BMP_RGB565_filterFloat(inPlace, inPlace, w, h, types[t], 2.0f) == 0);
+    CHECK(memcmp(inPlace, outOfPlace, sizeof(values)) == 0);
+
+    BMP_RGB565_free(copy);
+    BMP_RGB565_free(dst);
+  }
+  BMP_RGB565_free(src);
+}
+
+static void testWriter(void)
+{
+  BMP_RGB565_writer_t *writer = BMP_RGB565_writerCreate(13, 7, 2, 0, 0);
+  uint8_t buf[BMP_RGB565_HEADER_SIZE + 28 * 7];
+  FILE *fp;
+
+  CHECK(writer != NULL);
+  if(writer == NULL)
+    return;
+
+  uint8_t *pbmp = BMP_RGB565_writerAcquire(writer);
+  BMP_RGB565_fill565(pbmp, 0x1234);
+  CHECK(BMP_RGB565_writerSubmit(writer, pbmp, "test_writer.bmp") == 0);
+  CHECK(BMP_RGB565_writerSubmit(writer, pbmp, "test_writer.bmp") != 0);   // already queued
+  CHECK(BMP_RGB565_writerFlush(writer) == 0);
+  CHECK(BMP_RGB565_writerRelease(writer, pbmp) != 0);                     // already free
+
+  fp = fopen("test_writer.bmp", "rb");
+  CHECK(fp != NULL);
+  if(fp != NULL) {
+    CHECK(fread(buf, 1, sizeof(buf), fp) == sizeof(buf) && BMP_RGB565_getFileSize(buf) == sizeof(buf));
+    CHECK(BMP_RGB565_getPixel565(buf, 12, 6) == 0x1234);
+    fclose(fp);
+  }
+  remove("test_writer.bmp");
+
+  // A failed write fails the next flush only
+  pbmp = BMP_RGB565_writerAcquire(writer);
+  CHECK(BMP_RGB565_writerSubmit(writer, pbmp, "no_such_directory/test_writer.bmp") == 0);
+  CHECK(BMP_RGB565_writerFlush(writer) != 0);
+  CHECK(BMP_RGB565_writerFlush(writer) == 0);
+
+  BMP_RGB565_writerDestroy(writer);
+}
+
+static void testRecording(void)
+{
+  const uint32_t w = 21, h = 11, count = 7;
+  uint8_t *frames[7];
+  static uint8_t file[16384];
+  size_t fileSize = 0;
+  FILE *fp;
+
+  // Keyframe every 3 frames, small changes in between (delta frames)
+  BMP_RGB565_recWriter_t *writer = BMP_RGB565_recCreate("test.rec", w, h, 3);
+  CHECK(writer != NULL);
+  if(writer == NULL)
+    return;
+  for(uint32_t i = 0; i < count; i++) {
+    frames[i] = (i == 0) ? createPattern(w, h) : BMP_RGB565_copy(frames[i - 1]);
+    BMP_RGB565_drawLine565(frames[i], 0, i, w - 1, i, (uint16_t)(0xF000 + i));
+    CHECK(BMP_RGB565_recAppend(writer, frames[i], 1000 + 40 * i) == 0);
+  }
+  CHECK(BMP_RGB565_recClose(writer) == 0);
+
+  BMP_RGB565_recReader_t *reader = BMP_RGB565_recOpen("test.rec");
+  CHECK(reader != NULL && BMP_RGB565_recGetFrameCount(reader) == count);
+  if(reader != NULL) {
+    uint8_t *pbmp = BMP_RGB565_create(w, h);
+    CHECK(BMP_RGB565_recGetPixels(reader, 3) != NULL);  // keyframe: zero-copy
+    CHECK(BMP_RGB565_recGetPixels(reader, 4) == NULL);  // delta frame
+    CHECK(BMP_RGB565_recFindFrame(reader, 1100) == 2);
+    // Random access decodes from the nearest keyframe
+    const uint32_t order[] = {5, 1, 6, 0, 4, 2, 3};
+    for(uint32_t i = 0; i < count; i++) {
+      uint32_t f = order[i];
+      CHECK(BMP_RGB565_recReadFrame(reader, f, pbmp) == 0 && isSameImage(pbmp, frames[f]));
+      CHECK(BMP_RGB565_get565(BMP_RGB565_recGetRow(reader, f, f), 3) == 0xF000 + f);
+    }
+    BMP_RGB565_free(pbmp);
+    BMP_RGB565_recFree(reader);
+  }
+
+  // Truncated recording (no index): complete frames are still readable
+  fp = fopen("test.rec", "rb");
+  if(fp != NULL) {
+    fileSize = fread(file, 1, sizeof(file), fp);
+    fclose(fp);
+  }
+  CHECK(fileSize > 0 && fileSize < sizeof(file));
+  fp = fopen("test.rec", "wb");
+  if(fp != NULL) {
+    fwrite(file, 1, fileSize / 2, fp);
+    fclose(fp);
+  }
+  reader = BMP_RGB565_recOpen("test.rec");
+  CHECK(reader != NULL && BMP_RGB565_recGetFrameCount(reader) > 0 && BMP_RGB565_recGetFrameCount(reader) < count);
+  if(reader != NULL) {
+    uint8_t *pbmp = BMP_RGB565_create(w, h);
+    for(uint32_t f = 0; f < BMP_RGB565_recGetFrameCount(reader); f++)
+      CHECK(BMP_RGB565_recReadFrame(reader, f, pbmp) == 0 && isSameImage(pbmp, frames[f]));
+    BMP_RGB565_free(pbmp);
+    BMP_RGB565_recFree(reader);
+  }
+  remove("test.rec");
+
+  for(uint32_t i = 0; i < count; i++)
+    BMP_RGB565_free(frames[i]);
+}
+
+static void testIndexed(void)
+{
+  const uint32_t w = 31, h = 13;
+
+  for(uint32_t bits = 4; bits <= 8; bits += 4) {
+    uint8_t *indexed = BMP_RGB565_createIndexed(w, h, bits);
+    uint8_t *rgb     = BMP_RGB565_create(w, h);
+    uint8_t *text    = BMP_RGB565_create(w, h);
+    uint16_t lut[256];
+    int same = 1;
+
+    CHECK(indexed != NULL && BMP_RGB565_getBitCount(indexed) == bits);
+    CHECK(BMP_RGB565_getFileSize(indexed) == BMP_RGB565_calcIndexedFileSize(w, h, bits));
+    CHECK(BMP_RGB565_setColorScalePalette(indexed, 16) == 0);
+    CHECK(BMP_RGB565_getPalette565(indexed, lut) == (1u << bits));
+
+    // Text in palette indices has the same pixels as text in RGB565
+    BMP_RGB565_fillIndex(indexed, 2);
+    BMP_RGB565_drawTextIndex(indexed, "A1g", BMP_RGB565_FONT_6X10, 3, 2, 9);
+    BMP_RGB565_fill565(text, lut[2]);
+    BMP_RGB565_drawText565(text, "A1g", BMP_RGB565_FONT_6X10, 3, 2, lut[9]);
+    CHECK(BMP_RGB565_expandIndexed(indexed, rgb) == 0);
+    CHECK(isSameImage(rgb, text));
+    for(uint32_t y = 0; y < h; y++)
+      for(uint32_t x = 0; x < w; x++)
+        same &= BMP_RGB565_getPixel565(rgb, x, y) == lut[BMP_RGB565_getPixelIndex(indexed, x, y)];
+    CHECK(same);
+
+    // RGB565 functions leave indexed images alone
+    uint8_t *copy = BMP_RGB565_copy(indexed);
+    BMP_RGB565_setPixel565(indexed, w - 1, h - 1, 0xFFFF);
+    BMP_RGB565_fill565(indexed, 0xFFFF);
+    BMP_RGB565_drawText565(indexed, "A", BMP_RGB565_FONT_6X10, 0, 0, 0xFFFF);
+    BMP_RGB565_rotate180(indexed);
+    BMP_RGB565_flipHorizontal(indexed);
+    BMP_RGB565_scroll565(indexed, 0, 0, w - 1, h - 1, 1, 1, 0xFFFF);
+    CHECK(BMP_RGB565_filter(indexed, indexed, BMP_RGB565_FILTER_BOX, 1.0f) != 0);
+    CHECK(BMP_RGB565_getRow(indexed, 0) == NULL);
+    CHECK(BMP_RGB565_rotate90(indexed) == NULL);
+    CHECK(isSameImage(indexed, copy));
+
+    BMP_RGB565_free(copy);
+    BMP_RGB565_free(text);
+    BMP_RGB565_free(rgb);
+    BMP_RGB565_free(indexed);
+  }
+}
+
+static void testView(void)
+{
+  const uint32_t w = 23, h = 17;
+  uint8_t *pbmp = createPattern(w, h);
+  BMP_RGB565_view_st view, sub;
+
+  // Regions are clipped to the image; empty regions fail
+  CHECK(BMP_RGB565_viewInit(&view, pbmp, -5, 10, 12, 20) == 0);
+  CHECK(view.x == 0 && view.y == 10 && view.width == 7 && view.height == 7);
+  CHECK(BMP_RGB565_viewGetPixel565(&view, 2, 3) == 13 * w + 2 + 1);
+  CHECK(BMP_RGB565_viewGetRow(&view, 7) == NULL);
+  CHECK(BMP_RGB565_viewSub(&sub, &view, 5, 5, 10, 10) == 0);
+  CHECK(sub.x == 5 && sub.y == 15 && sub.width == 2 && sub.height == 2);
+  CHECK(BMP_RGB565_viewInit(&view, pbmp, (int32_t)w, 0, 4, 4) != 0);
+  CHECK(BMP_RGB565_viewInit(&view, pbmp, -4, -4, 4, 4) != 0);
+  CHECK(BMP_RGB565_viewInit(&view, pbmp, 0, 0, 0, 4) != 0);
+
+  // Drawing on a view stays inside its region
+  uint8_t *ref = createPattern(w, h);
+  CHECK(BMP_RGB565_viewInit(&view, pbmp, 4, 3, 6, 5) == 0);
+  BMP_RGB565_viewFill565(&view, 0x1234);
+  BMP_RGB565_viewDrawLine565(&view, -10, 2, 30, 2, 0xFFFF);
+  for(uint32_t y = 3; y < 8; y++)
+    for(uint32_t x = 4; x < 10; x++)
+      BMP_RGB565_setPixel565(ref, x, y, (y == 5) ? 0xFFFF : 0x1234);
+  CHECK(isSameImage(pbmp, ref));
+  BMP_RGB565_free(ref);
+
+  // Resizing to an empty image has nothing to resample
+  uint8_t *empty = BMP_RGB565_resize_bicubic(pbmp, 0, h);
+  CHECK(empty != NULL && BMP_RGB565_getWidth(empty) == 0 && BMP_RGB565_getHeight(empty) == h);
+  BMP_RGB565_free(empty);
+  empty = BMP_RGB565_resize_bicubic(pbmp, w, 0);
+  CHECK(empty != NULL && BMP_RGB565_getWidth(empty) == w && BMP_RGB565_getHeight(empty) == 0);
+  BMP_RGB565_free(empty);
+  BMP_RGB565_free(pbmp);
+
+  // Blit between overlapping regions of the same image, in both directions
+  const int32_t shifts[4][2] = {{3, 2}, {-3, -2}, {4, -1}, {-2, 5}};
+  for(uint32_t i = 0; i < 4; i++) {
+    int32_t sx = shifts[i][0], sy = shifts[i][1];
+    BMP_RGB565_view_st src, dst;
+    pbmp = createPattern(w, h);
+    ref  = createPattern(w, h);
+    CHECK(BMP_RGB565_viewInit(&src, pbmp, 5, 5, 12, 9) == 0);
+    CHECK(BMP_RGB565_viewInit(&dst, pbmp, 0, 0, w, h) == 0);
+    BMP_RGB565_viewBlit(&src, &dst, 5 + sx, 5 + sy);
+    for(int32_t y = 0; y < 9; y++)
+      for(int32_t x = 0; x < 12; x++)
+        BMP_RGB565_setPixel565(ref, 5 + sx + x, 5 + sy + y, (uint16_t)((5 + y) * w + 5 + x + 1));
+    CHECK(isSameImage(pbmp, ref));
+    BMP_RGB565_free(ref);
+    BMP_RGB565_free(pbmp);
+  }
+
+  // Blit clipped at the edges of the destination
+  pbmp = createPattern(w, h);
+  ref  = BMP_RGB565_create(w, h);
+  CHECK(BMP_RGB565_viewInit(&view, pbmp, 0, 0, w, h) == 0);
+  CHECK(BMP_RGB565_viewInit(&sub, ref, 0, 0, w, h) == 0);
+  BMP_RGB565_viewBlit(&view, &sub, -3, 4);
+  CHECK(BMP_RGB565_getPixel565(ref, 0, 4) == 3 + 1);
+  CHECK(BMP_RGB565_getPixel565(ref, w - 4, h - 1) == (h - 5) * w + w - 1 + 1);
+  CHECK(BMP_RGB565_getPixel565(ref, w - 3, 4) == 0 && BMP_RGB565_getPixel565(ref, 0, 3) == 0);
+  BMP_RGB565_free(ref);
+  BMP_RGB565_free(pbmp);
+}
+
+// Output function of BMP_RGB565_tiledExport() appending to a memory buffer
+typedef struct {
+  uint8_t *data;
+  size_t size, capacity;
+} memWriter_st;
+
+static int writeMemory(void *ctx, const void *data, size_t size)
+{
+  memWriter_st *mem = (memWriter_st *)ctx;
+  if(size > mem->capacity - mem->size)
+    return -1;
+  memcpy(mem->data + mem->size, data, size);
+  mem->size += size;
+  return 0;
+}
+
+static void testTiled(void)
+{
+  // Sizes beyond the limits of a BMP file
+  CHECK(BMP_RGB565_calcFileSize(0x80000000u, 1) == 0);
+  CHECK(BMP_RGB565_calcFileSize(70000, 70000) == 0);
+  CHECK(BMP_RGB565_create(0x80000000u, 1) == NULL);
+  CHECK(BMP_RGB565_create(70000, 70000) == NULL);
+  CHECK(BMP_RGB565_writerCreate(0x7FFFFFFF, 0x7FFFFFFF, 2, 0, 0) == NULL);
+  CHECK(BMP_RGB565_writerCreate(70000, 70000, 2, 0, 0) == NULL);
+
+  // Not a multiple of the tile size
+  const uint32_t w = 130, h = 77;
+  uint8_t *pbmp = createPattern(w, h);
+  BMP_RGB565_tiled_t *tiled = BMP_RGB565_tiledFromImage(pbmp);
+  CHECK(tiled != NULL);
+  if(tiled == NULL) {
+    BMP_RGB565_free(pbmp);
+    return;
+  }
+  CHECK(BMP_RGB565_tiledGetWidth(tiled) == w && BMP_RGB565_tiledGetHeight(tiled) == h);
+  CHECK(BMP_RGB565_tiledGetPixel565(tiled, 129, 76) == BMP_RGB565_getPixel565(pbmp, 129, 76));
+
+  // Export writes the same file as the linear image
+  memWriter_st mem;
+  mem.capacity = BMP_RGB565_getFileSize(pbmp);
+  mem.size = 0;
+  mem.data = (uint8_t *)malloc(mem.capacity);
+  CHECK(BMP_RGB565_tiledExport(tiled, writeMemory, &mem) == 0);
+  CHECK(mem.size == mem.capacity && memcmp(mem.data, pbmp, mem.size) == 0);
+  free(mem.data);
+
+  // Region across tile boundaries, and the whole image
+  BMP_RGB565_view_st view;
+  uint8_t *region = BMP_RGB565_tiledToImage(tiled, 60, 10, 70, 60);
+  CHECK(BMP_RGB565_viewInit(&view, pbmp, 60, 10, 70, 60) == 0);
+  uint8_t *ref = BMP_RGB565_viewToImage(&view);
+  CHECK(isSameImage(region, ref));
+  BMP_RGB565_free(ref);
+  BMP_RGB565_free(region);
+  region = BMP_RGB565_tiledToImage(tiled, 0, 0, w, h);
+  CHECK(isSameImage(region, pbmp));
+  BMP_RGB565_free(region);
+
+  // Rotation matches the linear image
+  BMP_RGB565_tiled_t *rotated = BMP_RGB565_tiledRotate90(tiled);
+  ref = BMP_RGB565_rotate90(pbmp);
+  region = (rotated != NULL) ? BMP_RGB565_tiledToImage(rotated, 0, 0, h, w) : NULL;
+  CHECK(isSameImage(region, ref));
+  BMP_RGB565_free(region);
+  BMP_RGB565_free(ref);
+  BMP_RGB565_tiledFree(rotated);
+
+  BMP_RGB565_tiledFree(tiled);
+  BMP_RGB565_free(pbmp);
+}
 
 int main(void)
 {
@@ -65,5 +599,24 @@ int main(void)
 
   BMP_RGB565_free(pbmp);
   BMP_RGB565_free(pbmp_resize);
+
+  // Behaviour checks
+  testPixel565();
+  testRotate();
+  testScroll();
+  testStatistics();
+  testPackedFont();
+  testFilter();
+  testWriter();
+  testRecording();
+  testIndexed();
+  testView();
+  testTiled();
+
+  if(failures > 0) {
+    printf("%d check(s) failed\n", failures);
+    return -1;
+  }
+  printf("All checks passed\n");
   return 0;
 }
@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include "bmp_rgb565.hpp"
+
+static int failures = 0;
+
+#define CHECK(_COND_) do { \
+    if(!(_COND_)) { \
+      printf("FAILED: %s (line %d)\n", #_COND_, __LINE__); \
+      failures++; \
+    } \
+  } while(0)
+
+// Compare a fixed-size image with the same pattern drawn by the C library
+template <uint32_t W, uint32_t H, bool TopDown>
+static void testBitmap(void)
+{
+  static bmp565::Bitmap<W, H, TopDown> bitmap;
+  uint8_t *pbmp = BMP_RGB565_create(W, H);
+  int same = 1;
+
+  CHECK(bitmap.FILE_SIZE == BMP_RGB565_calcFileSize(W, H));
+  CHECK(BMP_RGB565_getFileSize(bitmap.data()) == bitmap.FILE_SIZE);
+  CHECK(BMP_RGB565_getWidth(bitmap.data()) == W && BMP_RGB565_getHeight(bitmap.data()) == H);
+
+  for(uint32_t y = 0; y < H; y++)
+    for(uint32_t x = 0; x < W; x++) {
+      bitmap.setPixel(x, y, (uint16_t)(y * W + x + 1));
+      BMP_RGB565_setPixel565(pbmp, x, y, (uint16_t)(y * W + x + 1));
+    }
+  bitmap.drawLine(0, 0, W - 1, H - 1, 0xF800);
+  BMP_RGB565_drawLine565(pbmp, 0, 0, W - 1, H - 1, 0xF800);
+  bitmap.drawRect(1, 1, 3, 2, 0x07E0);
+  BMP_RGB565_drawRect565(pbmp, 1, 1, 3, 2, 0x07E0);
+
+  for(uint32_t y = 0; y < H; y++)
+    for(uint32_t x = 0; x < W; x++) {
+      same &= bitmap.getPixel(x, y) == BMP_RGB565_getPixel565(pbmp, x, y);
+      same &= BMP_RGB565_getPixel565(bitmap.data(), x, y) == BMP_RGB565_getPixel565(pbmp, x, y);
+      same &= BMP_RGB565_getRow(bitmap.data(), y) == bitmap.row(y);
+    }
+  CHECK(same);
+  CHECK(bitmap.getPixel(W, 0) == 0 && bitmap.getPixel(0, H) == 0);
+  // A bottom-up bitmap is the same file as a C image
+  if(!TopDown)
+    CHECK(memcmp(bitmap.data(), pbmp, bitmap.FILE_SIZE) == 0);
+  BMP_RGB565_free(pbmp);
+}
+
+static void testImage(void)
+{
+  bmp565::Image image(13, 7);
+  CHECK(image && image.width() == 13 && image.height() == 7);
+  CHECK(image.size() == BMP_RGB565_calcFileSize(13, 7));
+  image.setPixel(12, 6, 0x1234);
+  uint8_t *pbmp = image.data();
+
+  // Move construction and assignment transfer the buffer
+  bmp565::Image moved(std::move(image));
+  CHECK(!image && image.data() == nullptr && image.width() == 0 && image.height() == 0);
+  CHECK(moved.data() == pbmp && moved.width() == 13 && moved.getPixel(12, 6) == 0x1234);
+  bmp565::Image assigned(3, 3);
+  assigned = std::move(moved);
+  CHECK(!moved && assigned.data() == pbmp && assigned.width() == 13);
+
+  // Release gives the buffer back to the caller
+  pbmp = assigned.release();
+  CHECK(!assigned && assigned.size() == 0 && BMP_RGB565_getPixel565(pbmp, 12, 6) == 0x1234);
+  bmp565::Image owner(pbmp);
+  CHECK(owner.data() == pbmp && owner.height() == 7 && owner.row(6) == BMP_RGB565_getRow(pbmp, 6));
+  owner.reset(BMP_RGB565_create(5, 4));
+  CHECK(owner && owner.width() == 5 && owner.height() == 4);
+
+  // Indexed images have no RGB565 rows
+  bmp565::Image indexed(BMP_RGB565_createIndexed(5, 4, 8));
+  CHECK(!indexed && indexed.width() == 0);
+  owner.reset(BMP_RGB565_createIndexed(5, 4, 4));
+  CHECK(!owner && owner.row(0) == nullptr);
+}
+
+int main(void)
+{
+  BMP_RGB565_setAllocFunc(malloc, free);
+
+  testBitmap<13, 7, false>();
+  testBitmap<13, 7, true>();
+  testBitmap<16, 1, false>();
+  testImage();
+
+  if(failures > 0) {
+    printf("%d check(s) failed\n", failures);
+    return -1;
+  }
+  printf("All checks passed\n");
+  return 0;
+}
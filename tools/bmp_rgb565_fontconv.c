@@ -0,0 +1,133 @@
+/**
+ * Convert a built-in font table of bmp_rgb565.c to a packed font.
+ *
+ * Build : gcc -o fontconv tools/bmp_rgb565_fontconv.c -lm
+ * Usage : ./fontconv <font> <output> [-r first-last] [-s subset] [-c name]
+ *   font   : 4X6, 5X8, 5X12, 6X8, 6X10, 7X12, 8X8, 8X12, 8X14, 10X16,
+ *            12X16, 12X20, 16X26, 22X36, 24X40, 32X53
+ *   -r     : character code range (default: 32-126)
+ *   -s     : characters to keep in the range (default: all)
+ *   -c     : write a C source with `const uint8_t name[]` instead of a binary blob
+ *
+ * Example: ./fontconv 12X20 digits.bfnt -r 32-57 -s "0123456789.-+ "
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// All fonts are needed here, so the tables are compiled into this tool only
+#define USE_FONT_4X6
+#define USE_FONT_5X8
+#define USE_FONT_5X12
+#define USE_FONT_6X8
+#define USE_FONT_6X10
+#define USE_FONT_7X12
+#define USE_FONT_8X8
+#define USE_FONT_8X12
+#define USE_FONT_8X14
+#define USE_FONT_10X16
+#define USE_FONT_12X16
+#define USE_FONT_12X20
+#define USE_FONT_16X26
+#define USE_FONT_22X36
+#define USE_FONT_24X40
+#define USE_FONT_32X53
+#include "../bmp_rgb565.c"
+
+static const struct
+{
+    const char *name;
+    const BMP_RGB565_font_st *font;
+} fonts[] = {
+    {"4X6",   &BMP_RGB565_FONT_4X6},
+    {"5X8",   &BMP_RGB565_FONT_5X8},
+    {"5X12",  &BMP_RGB565_FONT_5X12},
+    {"6X8",   &BMP_RGB565_FONT_6X8},
+    {"6X10",  &BMP_RGB565_FONT_6X10},
+    {"7X12",  &BMP_RGB565_FONT_7X12},
+    {"8X8",   &BMP_RGB565_FONT_8X8},
+    {"8X12",  &BMP_RGB565_FONT_8X12},
+    {"8X14",  &BMP_RGB565_FONT_8X14},
+    {"10X16", &BMP_RGB565_FONT_10X16},
+    {"12X16", &BMP_RGB565_FONT_12X16},
+    {"12X20", &BMP_RGB565_FONT_12X20},
+    {"16X26", &BMP_RGB565_FONT_16X26},
+    {"22X36", &BMP_RGB565_FONT_22X36},
+    {"24X40", &BMP_RGB565_FONT_24X40},
+    {"32X53", &BMP_RGB565_FONT_32X53},
+};
+
+static int usage(void)
+{
+    printf("Usage: fontconv <font> <output> [-r first-last] [-s subset] [-c name]\n");
+    return -1;
+}
+
+int main(int argc, char *argv[])
+{
+    const BMP_RGB565_font_st *font = NULL;
+    const char *subset = NULL;
+    const char *c_name = NULL;
+    int first = 32, last = 126;
+
+    if (argc < 3)
+        return usage();
+
+    for (size_t i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++)
+        if (strcmp(argv[1], fonts[i].name) == 0)
+            font = fonts[i].font;
+    if (font == NULL)
+    {
+        printf("Unknown font: %s\n", argv[1]);
+        return usage();
+    }
+
+    for (int i = 3; i + 1 < argc; i += 2)
+    {
+        if (strcmp(argv[i], "-r") == 0 && sscanf(argv[i + 1], "%d-%d", &first, &last) == 2)
+            continue;
+        else if (strcmp(argv[i], "-s") == 0)
+            subset = argv[i + 1];
+        else if (strcmp(argv[i], "-c") == 0)
+            c_name = argv[i + 1];
+        else
+            return usage();
+    }
+    if (first < 0 || last > 255 || first > last)
+    {
+        printf("Invalid range: %d-%d\n", first, last);
+        return -1;
+    }
+
+    size_t size = BMP_RGB565_packFont(*font, (uint8_t)first, (uint8_t)last, subset, NULL, 0);
+    uint8_t *blob = malloc(size);
+    if (size == 0 || blob == NULL || BMP_RGB565_packFont(*font, (uint8_t)first, (uint8_t)last, subset, blob, size) != size)
+    {
+        printf("Failed to pack font\n");
+        return -1;
+    }
+
+    FILE *fp = fopen(argv[2], c_name ? "w" : "wb");
+    if (fp == NULL)
+    {
+        printf("Failed to open file\n");
+        return -1;
+    }
+    if (c_name != NULL)
+    {
+        fprintf(fp, "#include <stdint.h>\n\n// %s, codes %d-%d\nconst uint8_t %s[%zu] = {", argv[1], first, last, c_name, size);
+        for (size_t i = 0; i < size; i++)
+            fprintf(fp, "%s0x%02X,", (i % 16) ? " " : "\n    ", blob[i]);
+        fprintf(fp, "\n};\n");
+    }
+    else if (fwrite(blob, 1, size, fp) != size)
+    {
+        printf("Failed to write file\n");
+        return -1;
+    }
+    fclose(fp);
+    free(blob);
+
+    printf("%s: %zu bytes\n", argv[2], size);
+    return 0;
+}